@@ -0,0 +1,81 @@
+// AabbBatch::Overlap throughput at every SIMD level the CPU supports: one query box against
+// 4096 boxes in runs of MaxBatch. Each level's hits are checked against the scalar kernel,
+// including runs that start unaligned and end on a partial batch.
+#include <BenchScene.h>
+#include <core/AabbBatch.h>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+	constexpr size_t BoxCount = 4096;
+	constexpr size_t QueryCount = 256;
+	constexpr int Repeats = 20;
+	constexpr int Runs = 5;
+
+	// Hit indices of every query over every box, as absolute box indices.
+	std::vector<uint32_t> CollectHits(const std::vector<Rectf>& _queries, const AabbSoA& _boxes, size_t _first, size_t _runLength)
+	{
+		std::vector<uint32_t> _all;
+		uint32_t _hits[AabbBatch::MaxBatch];
+		for (const Rectf& _query : _queries) {
+			for (size_t _begin = _first; _begin < _boxes.Size(); _begin += _runLength) {
+				const size_t _count = _boxes.Size() - _begin < _runLength ? _boxes.Size() - _begin : _runLength;
+				const size_t _found = AabbBatch::Overlap(_query, 0b0111, _boxes, _begin, _count, _hits);
+				for (size_t _hit = 0; _hit < _found; ++_hit) {
+					_all.push_back(static_cast<uint32_t>(_begin + _hits[_hit]));
+				}
+			}
+			_all.push_back(UINT32_MAX);
+		}
+		return _all;
+	}
+}
+
+int main()
+{
+	std::mt19937 _random(99u);
+	std::uniform_real_distribution<float> _position(0.0f, 1000.0f);
+	std::uniform_real_distribution<float> _size(4.0f, 48.0f);
+	AabbSoA _boxes;
+	for (size_t _index = 0; _index < BoxCount; ++_index) {
+		_boxes.Push(Rectf(_position(_random), _position(_random), _size(_random), _size(_random)), 1u << (_index % 4));
+	}
+	std::vector<Rectf> _queries;
+	for (size_t _index = 0; _index < QueryCount; ++_index) {
+		_queries.emplace_back(_position(_random), _position(_random), _size(_random) * 2.0f, _size(_random) * 2.0f);
+	}
+	// Shares edges with box 0, which must not count as an overlap.
+	_queries.emplace_back(_boxes.MaxX[0], _boxes.MinY[0], 10.0f, 10.0f);
+
+	const AabbBatch::SimdLevel _supported = AabbBatch::GetSupportedLevel();
+	AabbBatch::SetActiveLevel(AabbBatch::SimdLevel::Scalar);
+	const std::vector<uint32_t> _expectedFull = CollectHits(_queries, _boxes, 0, AabbBatch::MaxBatch);
+	const std::vector<uint32_t> _expectedOdd = CollectHits(_queries, _boxes, 3, AabbBatch::MaxBatch - 3);
+
+	std::printf("%zu boxes in runs of %zu, %zu queries, best of %d\n", BoxCount, AabbBatch::MaxBatch, _queries.size(), Runs);
+	const double _tests = static_cast<double>(_queries.size()) * BoxCount * Repeats;
+	for (int _level = 0; _level <= static_cast<int>(_supported); ++_level) {
+		AabbBatch::SetActiveLevel(static_cast<AabbBatch::SimdLevel>(_level));
+		const AabbBatch::SimdLevel _active = AabbBatch::GetActiveLevel();
+
+		size_t _hitCount = 0;
+		uint32_t _hits[AabbBatch::MaxBatch];
+		const double _milliseconds = Bench::BestMilliseconds(Runs, [&]() {
+			for (int _repeat = 0; _repeat < Repeats; ++_repeat) {
+				for (const Rectf& _query : _queries) {
+					for (size_t _begin = 0; _begin < BoxCount; _begin += AabbBatch::MaxBatch) {
+						_hitCount += AabbBatch::Overlap(_query, 0b0111, _boxes, _begin, AabbBatch::MaxBatch, _hits);
+					}
+				}
+			}
+		});
+
+		const bool _matches = CollectHits(_queries, _boxes, 0, AabbBatch::MaxBatch) == _expectedFull
+			&& CollectHits(_queries, _boxes, 3, AabbBatch::MaxBatch - 3) == _expectedOdd;
+		std::printf("  %-8s %8.0fM tests/s   matches scalar: %s   (%zu hits per pass)\n", AabbBatch::GetLevelName(_active),
+			_tests / (_milliseconds * 1e3), _matches ? "yes" : "NO", _hitCount / (Runs * Repeats));
+	}
+	return 0;
+}
@@ -0,0 +1,59 @@
+#include <BenchScene.h>
+#include <core/Camera.h>
+#include <core/Entity.h>
+#include <core/ResourceHandler.h>
+#include <core/World.h>
+#include <core/engine/PhysicsService.h>
+#include <core/engine/RenderService.h>
+#include <core/engine/RunnerService.h>
+#include <core/engine/ServiceOrder.h>
+#include <core/engine/WorldService.h>
+#include <SDL3/SDL.h>
+#include <stdexcept>
+
+BenchScene::BenchScene()
+	:Services(std::make_unique<GameServiceHost>()),
+	Texture(RUNNINGGUN_SOURCE_DIR "/sprites/bullet.png")
+{
+	Surface = SDL_CreateSurface(800, 600, SDL_PIXELFORMAT_RGBA32);
+	Renderer = Surface ? SDL_CreateSoftwareRenderer(Surface) : nullptr;
+	if (!Renderer) {
+		throw std::runtime_error(std::string("Could not create a software renderer: ") + SDL_GetError());
+	}
+
+	Services->AddService<RunnerService>(ServiceOrder::Runner);
+	Services->AddService<PhysicsService>(ServiceOrder::Physics);
+	auto& render = Services->AddService<RenderService>(ServiceOrder::Render, Renderer, std::make_unique<ResourceHandler>(Renderer), std::make_unique<Camera>(800.0f, 600.0f));
+	Services->AddService<WorldService>(ServiceOrder::World);
+
+	render.GetTextureHandler().Load(Texture);
+	Services->Init();
+}
+
+BenchScene::~BenchScene()
+{
+	// Textures and entities go before the renderer they were created with.
+	Services->Shutdown();
+	Services.reset();
+	SDL_DestroyRenderer(Renderer);
+	SDL_DestroySurface(Surface);
+}
+
+World& BenchScene::GetWorld() const
+{
+	return Services->Get<WorldService>().GetWorld();
+}
+
+Entity& BenchScene::CreateEntity(float x, float y, float width, float height)
+{
+	auto entity = std::make_unique<Entity>(*Services, Texture, width, height);
+	entity->SetPosition(x, y);
+	Entity& result = *entity;
+	GetWorld().AddObject(std::move(entity));
+	return result;
+}
+
+void BenchScene::Step()
+{
+	Services->FixedUpdate();
+}
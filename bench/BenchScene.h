@@ -0,0 +1,63 @@
+#pragma once
+
+#include <core/engine/GameServiceHost.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+class Entity;
+class World;
+struct SDL_Renderer;
+struct SDL_Surface;
+
+/**
+ * Headless stand-in for Engine: runner, physics, render and world services drawing into a
+ * software renderer, so benches build real scenes without a window or a game mode.
+ */
+class BenchScene
+{
+public:
+	BenchScene();
+	~BenchScene();
+
+	GameServiceHost& GetServices() { return *Services; }
+	World& GetWorld() const;
+
+	// A bullet-sized entity with its top-left corner at (x, y). Like any AddObject it joins
+	// the world at the start of the next step.
+	Entity& CreateEntity(float x, float y, float width = 16.0f, float height = 16.0f);
+
+	// One simulation step: physics gathers and pairs the active entities, then the world updates.
+	void Step();
+
+private:
+	SDL_Surface* Surface = nullptr;
+	SDL_Renderer* Renderer = nullptr;
+	std::unique_ptr<GameServiceHost> Services;
+	std::string Texture;
+};
+
+namespace Bench
+{
+	// Best of `runs` wall-clock timings of `body`, in milliseconds.
+	template <typename Fn>
+	double BestMilliseconds(int runs, Fn&& body)
+	{
+		double best = 1e30;
+		for (int run = 0; run < runs; ++run) {
+			const auto start = std::chrono::steady_clock::now();
+			body();
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			best = std::min(best, elapsed.count());
+		}
+		return best;
+	}
+
+	template <typename Fn>
+	double BestNanosecondsPer(int runs, size_t iterations, Fn&& body)
+	{
+		return BestMilliseconds(runs, body) * 1e6 / static_cast<double>(iterations);
+	}
+}
@@ -0,0 +1,88 @@
+// Entity::GetComponent<T> and HasComponents<...> against the dynamic_cast scan over an
+// entity's component list that GetComponent used to do.
+#include <BenchScene.h>
+#include <core/Component.h>
+#include <core/Entity.h>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+	constexpr size_t EntityCount = 4096;
+	constexpr size_t Lookups = 10000000;
+	constexpr int Runs = 5;
+
+	template <int N>
+	class LookupComponent : public Component
+	{
+	public:
+		LookupComponent(Entity& _entity, GameServiceHost& _context) : Component(_entity, _context) {}
+		uint32_t Value = N;
+	};
+
+	using First = LookupComponent<1>;
+	using Second = LookupComponent<2>;
+	using Third = LookupComponent<3>;
+	// Attached last, so the scan walks the whole list.
+	using Last = LookupComponent<4>;
+
+	template <typename Comp>
+	Comp* ScanForComponent(const std::vector<Component*>& _components)
+	{
+		for (Component* _component : _components) {
+			if (auto* _found = dynamic_cast<Comp*>(_component)) {
+				return _found;
+			}
+		}
+		return nullptr;
+	}
+
+	template <typename Comp>
+	Comp* Attach(Entity& _entity, GameServiceHost& _services, std::vector<Component*>& _list)
+	{
+		Comp* _component = _entity.AttachComponent(std::make_unique<Comp>(_entity, _services));
+		_list.push_back(_component);
+		return _component;
+	}
+}
+
+int main()
+{
+	BenchScene _scene;
+	GameServiceHost& _services = _scene.GetServices();
+
+	std::vector<Entity*> _entities;
+	std::vector<std::vector<Component*>> _lists(EntityCount);
+	for (size_t _index = 0; _index < EntityCount; ++_index) {
+		Entity& _entity = _scene.CreateEntity(static_cast<float>(_index % 64) * 32.0f, static_cast<float>(_index / 64) * 32.0f);
+		Attach<First>(_entity, _services, _lists[_index]);
+		Attach<Second>(_entity, _services, _lists[_index]);
+		Attach<Third>(_entity, _services, _lists[_index]);
+		Attach<Last>(_entity, _services, _lists[_index]);
+		_entities.push_back(&_entity);
+	}
+
+	uint64_t _checksum = 0;
+	const double _scan = Bench::BestNanosecondsPer(Runs, Lookups, [&]() {
+		for (size_t _i = 0; _i < Lookups; ++_i) {
+			_checksum += ScanForComponent<Last>(_lists[_i % EntityCount])->Value;
+		}
+	});
+	const double _slot = Bench::BestNanosecondsPer(Runs, Lookups, [&]() {
+		for (size_t _i = 0; _i < Lookups; ++_i) {
+			_checksum += _entities[_i % EntityCount]->GetComponent<Last>()->Value;
+		}
+	});
+	const double _mask = Bench::BestNanosecondsPer(Runs, Lookups, [&]() {
+		for (size_t _i = 0; _i < Lookups; ++_i) {
+			_checksum += _entities[_i % EntityCount]->HasComponents<First, Last>() ? 1 : 0;
+		}
+	});
+
+	std::printf("%zu entities x 4 components, %zu lookups of the last one, best of %d\n", EntityCount, Lookups, Runs);
+	std::printf("  dynamic_cast scan        %6.2f ns/lookup\n", _scan);
+	std::printf("  GetComponent<T>          %6.2f ns/lookup\n", _slot);
+	std::printf("  HasComponents<A, B>      %6.2f ns/test\n", _mask);
+	std::printf("checksum %llu\n", static_cast<unsigned long long>(_checksum));
+	return 0;
+}
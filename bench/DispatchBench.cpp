@@ -0,0 +1,153 @@
+// Component Update/PostUpdate dispatch over a stress scene: World's per-type batches against
+// the per-entity virtual walk it replaced, and against virtual calls over the same per-type
+// lists, which separates skipping non-overriding components from binding calls statically.
+#include <BenchScene.h>
+#include <core/Component.h>
+#include <core/ComponentType.h>
+#include <core/Entity.h>
+#include <core/World.h>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+	constexpr size_t EntityCount = 20000;
+	constexpr int Frames = 100;
+	constexpr int Runs = 5;
+	constexpr float StepTime = 1.0f / 60.0f;
+
+	class MotionComponent : public Component
+	{
+	public:
+		MotionComponent(Entity& _entity, GameServiceHost& _context, float _speed) : Component(_entity, _context), Speed(_speed) {}
+		void Update() override { Travelled += Speed * StepTime; }
+		float Travelled = 0.0f;
+		float Speed;
+	};
+
+	class PatrolComponent : public Component
+	{
+	public:
+		PatrolComponent(Entity& _entity, GameServiceHost& _context) : Component(_entity, _context) {}
+		void Update() override
+		{
+			Timer -= StepTime;
+			if (Timer <= 0.0f) {
+				Timer += 2.0f;
+				Direction = -Direction;
+			}
+		}
+		float Timer = 2.0f;
+		float Direction = 1.0f;
+	};
+
+	class ShooterComponent : public Component
+	{
+	public:
+		ShooterComponent(Entity& _entity, GameServiceHost& _context) : Component(_entity, _context) {}
+		void Update() override
+		{
+			Cooldown -= StepTime;
+			Fired = Cooldown <= 0.0f;
+		}
+		void PostUpdate() override
+		{
+			if (Fired) {
+				Cooldown += 0.5f;
+				++Shots;
+			}
+		}
+		float Cooldown = 0.5f;
+		uint32_t Shots = 0;
+		bool Fired = false;
+	};
+
+	// Data only, like a health or tag component; it overrides no phase.
+	class PassiveComponent : public Component
+	{
+	public:
+		PassiveComponent(Entity& _entity, GameServiceHost& _context) : Component(_entity, _context) {}
+		int Health = 3;
+	};
+}
+
+int main()
+{
+	BenchScene _scene;
+	GameServiceHost& _services = _scene.GetServices();
+	World& _world = _scene.GetWorld();
+
+	// 20k motion, 10k patrol, 5k shooter and 20k passive: 55k components, 35k of them override Update.
+	std::vector<Component*> _updateList[3];
+	std::vector<Component*> _postUpdateList;
+	size_t _componentCount = 0;
+	for (size_t _index = 0; _index < EntityCount; ++_index) {
+		Entity& _entity = _scene.CreateEntity(static_cast<float>(_index % 200) * 20.0f, static_cast<float>(_index / 200) * 20.0f);
+		_updateList[0].push_back(_entity.AttachComponent(std::make_unique<MotionComponent>(_entity, _services, 1.0f + static_cast<float>(_index % 7))));
+		if (_index % 2 == 0) {
+			_updateList[1].push_back(_entity.AttachComponent(std::make_unique<PatrolComponent>(_entity, _services)));
+			++_componentCount;
+		}
+		if (_index % 4 == 1) {
+			auto* _shooter = _entity.AttachComponent(std::make_unique<ShooterComponent>(_entity, _services));
+			_updateList[2].push_back(_shooter);
+			_postUpdateList.push_back(_shooter);
+			++_componentCount;
+		}
+		_entity.AttachComponent(std::make_unique<PassiveComponent>(_entity, _services));
+		_componentCount += 2;
+	}
+	// Brings the entities into the world and links their components into the phase lists.
+	_scene.Step();
+
+	const double _batched = Bench::BestMilliseconds(Runs, [&]() {
+		for (int _frame = 0; _frame < Frames; ++_frame) {
+			_world.Update();
+			_world.PostUpdate();
+		}
+	}) / Frames;
+	const double _perEntity = Bench::BestMilliseconds(Runs, [&]() {
+		for (int _frame = 0; _frame < Frames; ++_frame) {
+			for (auto& _entity : _world.GetActiveEntities()) {
+				_entity->UpdateComponents();
+			}
+			for (auto& _entity : _world.GetActiveEntities()) {
+				_entity->PostUpdateComponents();
+			}
+		}
+	}) / Frames;
+	const double _virtualLists = Bench::BestMilliseconds(Runs, [&]() {
+		for (int _frame = 0; _frame < Frames; ++_frame) {
+			for (auto& _list : _updateList) {
+				for (Component* _component : _list) {
+					_component->Update();
+				}
+			}
+			for (Component* _component : _postUpdateList) {
+				_component->PostUpdate();
+			}
+		}
+	}) / Frames;
+
+	// What RunPhase does per list, without the frame's sync points and animator walk.
+	const double _staticLists = Bench::BestMilliseconds(Runs, [&]() {
+		for (int _frame = 0; _frame < Frames; ++_frame) {
+			ComponentType::UpdateBatch<MotionComponent>(_updateList[0].data(), _updateList[0].size());
+			ComponentType::UpdateBatch<PatrolComponent>(_updateList[1].data(), _updateList[1].size());
+			ComponentType::UpdateBatch<ShooterComponent>(_updateList[2].data(), _updateList[2].size());
+			ComponentType::PostUpdateBatch<ShooterComponent>(_postUpdateList.data(), _postUpdateList.size());
+		}
+	}) / Frames;
+
+	uint64_t _shots = 0;
+	for (Component* _component : _postUpdateList) {
+		_shots += static_cast<ShooterComponent*>(_component)->Shots;
+	}
+	std::printf("%zu entities, %zu components, best of %d runs of %d frames\n", _world.GetActiveCount(), _componentCount, Runs, Frames);
+	std::printf("  per-entity virtual walk              %6.3f ms/frame\n", _perEntity);
+	std::printf("  World::Update + PostUpdate (batched) %6.3f ms/frame\n", _batched);
+	std::printf("  per-type lists, static batches       %6.3f ms/frame\n", _staticLists);
+	std::printf("  per-type lists, virtual calls        %6.3f ms/frame\n", _virtualLists);
+	std::printf("shots %llu\n", static_cast<unsigned long long>(_shots));
+	return 0;
+}
@@ -0,0 +1,108 @@
+// QuadTree build and query cost: random boxes of 8 to 64 units in a 4000x4000 world, from a
+// fixed seed so every run sees the same layout, rebuilt every frame and queried with every box.
+#include <BenchScene.h>
+#include <core/QuadTree.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+	constexpr float WorldSize = 4000.0f;
+	constexpr int Frames = 20;
+	constexpr int Runs = 3;
+	constexpr size_t CheckedQueries = 200;
+
+	struct Box
+	{
+		EntityHandle Handle;
+		Rectf Bounds;
+		CollisionLayerMask Layers;
+	};
+
+	std::vector<Box> MakeBoxes(size_t _count, uint32_t _seed)
+	{
+		std::mt19937 _random(_seed);
+		std::uniform_real_distribution<float> _position(0.0f, WorldSize - 64.0f);
+		std::uniform_real_distribution<float> _size(8.0f, 64.0f);
+		std::vector<Box> _boxes(_count);
+		for (size_t _index = 0; _index < _count; ++_index) {
+			_boxes[_index].Handle = { static_cast<uint32_t>(_index), 0 };
+			_boxes[_index].Bounds = Rectf(_position(_random), _position(_random), _size(_random), _size(_random));
+			_boxes[_index].Layers = 1u << (_index % 4);
+		}
+		return _boxes;
+	}
+
+	void BuildTree(QuadTree& _tree, const std::vector<Box>& _boxes)
+	{
+		_tree.Clear();
+		for (const Box& _box : _boxes) {
+			_tree.Insert(_box.Handle, _box.Bounds, _box.Layers);
+		}
+		_tree.Build();
+	}
+
+	bool MatchesBruteForce(const QuadTree& _tree, const std::vector<Box>& _boxes)
+	{
+		std::vector<EntityHandle> _found;
+		std::vector<uint32_t> _actual;
+		std::vector<uint32_t> _expected;
+		const CollisionLayerMask _mask = 0b0101;
+		for (size_t _query = 0; _query < CheckedQueries && _query < _boxes.size(); ++_query) {
+			const Rectf& _range = _boxes[_query * (_boxes.size() / CheckedQueries)].Bounds;
+			_found.clear();
+			_tree.Query(_range, _mask, _found);
+			_actual.clear();
+			for (const EntityHandle& _handle : _found) {
+				_actual.push_back(_handle.Index);
+			}
+			_expected.clear();
+			for (const Box& _box : _boxes) {
+				if ((_box.Layers & _mask) != 0 && _box.Bounds.Intersects(_range)) {
+					_expected.push_back(_box.Handle.Index);
+				}
+			}
+			std::sort(_actual.begin(), _actual.end());
+			if (_actual != _expected) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main()
+{
+	std::printf("random boxes in a %.0fx%.0f world, best of %d runs of %d frames\n", WorldSize, WorldSize, Runs, Frames);
+	std::printf("  %-8s %12s %18s %10s\n", "n", "build ms", "build+query ms", "matches");
+	for (const size_t _count : { size_t(1000), size_t(10000), size_t(50000) }) {
+		const std::vector<Box> _boxes = MakeBoxes(_count, 1234u);
+		QuadTree _tree(Rectf(0.0f, 0.0f, WorldSize, WorldSize));
+		std::vector<EntityHandle> _found;
+		size_t _hits = 0;
+
+		const double _build = Bench::BestMilliseconds(Runs, [&]() {
+			for (int _frame = 0; _frame < Frames; ++_frame) {
+				BuildTree(_tree, _boxes);
+			}
+		}) / Frames;
+		const double _buildQuery = Bench::BestMilliseconds(Runs, [&]() {
+			for (int _frame = 0; _frame < Frames; ++_frame) {
+				BuildTree(_tree, _boxes);
+				for (const Box& _box : _boxes) {
+					_found.clear();
+					_tree.Query(_box.Bounds, ~CollisionLayerMask(0), _found);
+					_hits += _found.size();
+				}
+			}
+		}) / Frames;
+
+		std::printf("  %-8zu %12.3f %18.3f %10s\n", _count, _build, _buildQuery, MatchesBruteForce(_tree, _boxes) ? "yes" : "NO");
+		if (_hits == 0) {
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,95 @@
+// GameServiceHost::Get/TryGet and ServiceRef against the std::type_index keyed map the
+// host used to keep, with as many services as Engine registers.
+#include <BenchScene.h>
+#include <core/engine/GameServiceHost.h>
+#include <core/engine/IService.h>
+#include <core/engine/ServiceRef.h>
+#include <cstdint>
+#include <cstdio>
+#include <typeindex>
+#include <unordered_map>
+
+namespace {
+	constexpr size_t Lookups = 10000000;
+	constexpr int Runs = 5;
+
+	template <int N>
+	class LookupService final : public IService
+	{
+	public:
+		uint64_t Value = N;
+	};
+
+	using First = LookupService<0>;
+	using Second = LookupService<1>;
+	using Third = LookupService<2>;
+	using Fourth = LookupService<3>;
+	using Fifth = LookupService<4>;
+	using Sixth = LookupService<5>;
+	// Registered last, like ObjectPoolService.
+	using Last = LookupService<6>;
+
+	using ServiceMap = std::unordered_map<std::type_index, IService*>;
+
+	template <typename T>
+	void AddBoth(GameServiceHost& _host, ServiceMap& _map, int _order)
+	{
+		_map[std::type_index(typeid(T))] = &_host.AddService<T>(_order);
+	}
+
+	template <typename T>
+	T& MapGet(const ServiceMap& _map)
+	{
+		return *static_cast<T*>(_map.find(std::type_index(typeid(T)))->second);
+	}
+}
+
+int main()
+{
+	GameServiceHost _host;
+	ServiceMap _map;
+	AddBoth<First>(_host, _map, 0);
+	AddBoth<Second>(_host, _map, 10);
+	AddBoth<Third>(_host, _map, 20);
+	AddBoth<Fourth>(_host, _map, 30);
+	AddBoth<Fifth>(_host, _map, 40);
+	AddBoth<Sixth>(_host, _map, 50);
+	AddBoth<Last>(_host, _map, 60);
+	_host.Init();
+	const ServiceRef<Last> _ref(_host);
+
+	// Read back through volatile pointers so the lookups cannot be hoisted out of the loops.
+	GameServiceHost* volatile _hostPtr = &_host;
+	const ServiceMap* volatile _mapPtr = &_map;
+	const ServiceRef<Last>* volatile _refPtr = &_ref;
+
+	uint64_t _checksum = 0;
+	const double _mapGet = Bench::BestNanosecondsPer(Runs, Lookups, [&]() {
+		for (size_t _i = 0; _i < Lookups; ++_i) {
+			_checksum += MapGet<Last>(*_mapPtr).Value;
+		}
+	});
+	const double _get = Bench::BestNanosecondsPer(Runs, Lookups, [&]() {
+		for (size_t _i = 0; _i < Lookups; ++_i) {
+			_checksum += _hostPtr->Get<Last>().Value;
+		}
+	});
+	const double _tryGet = Bench::BestNanosecondsPer(Runs, Lookups, [&]() {
+		for (size_t _i = 0; _i < Lookups; ++_i) {
+			_checksum += _hostPtr->TryGet<Last>()->Value;
+		}
+	});
+	const double _cached = Bench::BestNanosecondsPer(Runs, Lookups, [&]() {
+		for (size_t _i = 0; _i < Lookups; ++_i) {
+			_checksum += (*_refPtr)->Value;
+		}
+	});
+
+	std::printf("7 services, %zu lookups of the last registered, best of %d\n", Lookups, Runs);
+	std::printf("  type_index map           %6.2f ns/lookup\n", _mapGet);
+	std::printf("  GameServiceHost::Get     %6.2f ns/lookup\n", _get);
+	std::printf("  GameServiceHost::TryGet  %6.2f ns/lookup\n", _tryGet);
+	std::printf("  ServiceRef               %6.2f ns/lookup\n", _cached);
+	std::printf("checksum %llu\n", static_cast<unsigned long long>(_checksum));
+	return 0;
+}
@@ -0,0 +1,239 @@
+// PhysicsService spatial queries on every broadphase backend: 5000 entities scattered over a
+// 4000x4000 world, 1000 queries of each kind per pass. Each backend is also checked against a
+// brute-force scan of the pass's proxies.
+#include <BenchScene.h>
+#include <core/Entity.h>
+#include <core/engine/PhysicsService.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+	constexpr size_t EntityCount = 5000;
+	constexpr float WorldSize = 4000.0f;
+	constexpr size_t QueryCount = 1000;
+	constexpr size_t CheckedQueries = 200;
+	constexpr float CircleRadius = 96.0f;
+	constexpr float RayLength = 600.0f;
+	constexpr int Runs = 5;
+	constexpr CollisionLayerMask QueryLayers = LayerOf(hazard) | LayerOf(pickup);
+
+	struct Query
+	{
+		Rectf Range;
+		Vec2 Point;
+		Vec2 Direction;
+	};
+
+	struct Backend
+	{
+		const char* Name;
+		BroadphaseType Type;
+	};
+
+	float DistanceSquaredToRect(const Vec2& _point, const Rectf& _rect)
+	{
+		const float _dx = std::max({ _rect.Left() - _point.x, 0.0f, _point.x - _rect.Right() });
+		const float _dy = std::max({ _rect.Top() - _point.y, 0.0f, _point.y - _rect.Bottom() });
+		return _dx * _dx + _dy * _dy;
+	}
+
+	// Same slab test PhysicsService uses, against a normalized direction.
+	bool RayHitsRect(const Vec2& _origin, const Vec2& _direction, float _maxDistance, const Rectf& _rect, float& _distance)
+	{
+		float _enter = 0.0f;
+		float _exit = _maxDistance;
+		const float _origins[2] = { _origin.x, _origin.y };
+		const float _directions[2] = { _direction.x, _direction.y };
+		const float _mins[2] = { _rect.Left(), _rect.Top() };
+		const float _maxs[2] = { _rect.Right(), _rect.Bottom() };
+		for (int _axis = 0; _axis < 2; ++_axis) {
+			if (std::fabs(_directions[_axis]) < 1.0e-8f) {
+				if (_origins[_axis] < _mins[_axis] || _origins[_axis] > _maxs[_axis]) {
+					return false;
+				}
+				continue;
+			}
+			const float _inverse = 1.0f / _directions[_axis];
+			const float _near = std::min((_mins[_axis] - _origins[_axis]) * _inverse, (_maxs[_axis] - _origins[_axis]) * _inverse);
+			const float _far = std::max((_mins[_axis] - _origins[_axis]) * _inverse, (_maxs[_axis] - _origins[_axis]) * _inverse);
+			_enter = std::max(_enter, _near);
+			_exit = std::min(_exit, _far);
+			if (_enter > _exit) {
+				return false;
+			}
+		}
+		_distance = _enter;
+		return true;
+	}
+
+	std::vector<uint32_t> Indices(const std::vector<EntityHandle>& _handles)
+	{
+		std::vector<uint32_t> _indices;
+		for (const EntityHandle& _handle : _handles) {
+			_indices.push_back(_handle.Index);
+		}
+		std::sort(_indices.begin(), _indices.end());
+		return _indices;
+	}
+
+	bool MatchesBruteForce(const PhysicsService& _physics, const std::vector<Query>& _queries)
+	{
+		const std::vector<BroadphaseProxy>& _proxies = _physics.GetBroadphaseProxies();
+		std::vector<EntityHandle> _found;
+		std::vector<RaycastHit> _hits;
+		for (size_t _index = 0; _index < CheckedQueries; ++_index) {
+			const Query& _query = _queries[_index];
+			const Vec2 _unit = _query.Direction / std::sqrt(_query.Direction.x * _query.Direction.x + _query.Direction.y * _query.Direction.y);
+			const Rectf _circleBox(_query.Point.x - CircleRadius, _query.Point.y - CircleRadius, CircleRadius * 2.0f, CircleRadius * 2.0f);
+
+			std::vector<EntityHandle> _rect;
+			std::vector<EntityHandle> _circle;
+			std::vector<uint32_t> _rayAll;
+			EntityHandle _ray;
+			float _rayDistance = RayLength;
+			EntityHandle _nearest;
+			float _nearestSquared = 1.0e30f;
+			for (const BroadphaseProxy& _proxy : _proxies) {
+				if ((_proxy.Layers & QueryLayers) == 0) {
+					continue;
+				}
+				if (_proxy.Bounds.Intersects(_query.Range)) {
+					_rect.push_back(_proxy.Handle);
+				}
+				if (_proxy.Bounds.Intersects(_circleBox) && DistanceSquaredToRect(_query.Point, _proxy.Bounds) <= CircleRadius * CircleRadius) {
+					_circle.push_back(_proxy.Handle);
+				}
+				float _distance;
+				if (RayHitsRect(_query.Point, _unit, RayLength, _proxy.Bounds, _distance)) {
+					_rayAll.push_back(_proxy.Handle.Index);
+					if (!_ray.IsValid() || _distance < _rayDistance || (_distance == _rayDistance && _proxy.Handle.Index < _ray.Index)) {
+						_ray = _proxy.Handle;
+						_rayDistance = _distance;
+					}
+				}
+				const float _distanceSquared = DistanceSquaredToRect(_query.Point, _proxy.Bounds);
+				if (_distanceSquared < _nearestSquared || (_distanceSquared == _nearestSquared && _proxy.Handle.Index < _nearest.Index)) {
+					_nearest = _proxy.Handle;
+					_nearestSquared = _distanceSquared;
+				}
+			}
+
+			_found.clear();
+			_physics.QueryRect(_query.Range, QueryLayers, _found);
+			if (Indices(_found) != Indices(_rect)) {
+				return false;
+			}
+			_found.clear();
+			_physics.QueryCircle(_query.Point, CircleRadius, QueryLayers, _found);
+			if (Indices(_found) != Indices(_circle)) {
+				return false;
+			}
+			RaycastHit _hit;
+			const bool _didHit = _physics.Raycast(_query.Point, _query.Direction, RayLength, QueryLayers, _hit);
+			if (_didHit != _ray.IsValid() || (_didHit && _hit.Distance != _rayDistance)) {
+				return false;
+			}
+			_hits.clear();
+			_physics.RaycastAll(_query.Point, _query.Direction, RayLength, QueryLayers, _hits);
+			std::vector<uint32_t> _allIndices;
+			for (const RaycastHit& _each : _hits) {
+				_allIndices.push_back(_each.Entity.Index);
+			}
+			std::sort(_allIndices.begin(), _allIndices.end());
+			std::sort(_rayAll.begin(), _rayAll.end());
+			if (_allIndices != _rayAll) {
+				return false;
+			}
+			if (_physics.FindNearest(_query.Point, QueryLayers) != _nearest) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main()
+{
+	BenchScene _scene;
+	PhysicsService& _physics = _scene.GetServices().Get<PhysicsService>();
+	_physics.SetWorldBounds(Rectf(0.0f, 0.0f, WorldSize, WorldSize));
+
+	std::mt19937 _random(7u);
+	std::uniform_real_distribution<float> _position(0.0f, WorldSize - 64.0f);
+	std::uniform_real_distribution<float> _size(8.0f, 48.0f);
+	std::uniform_real_distribution<float> _angle(0.0f, 6.2831853f);
+	const ENTITY_TAG _tags[] = { hazard, pickup, bullet };
+	for (size_t _index = 0; _index < EntityCount; ++_index) {
+		Entity& _entity = _scene.CreateEntity(_position(_random), _position(_random), _size(_random), _size(_random));
+		_entity.SetTag(_tags[_index % 3]);
+	}
+	std::vector<Query> _queries(QueryCount);
+	for (Query& _query : _queries) {
+		_query.Range = Rectf(_position(_random), _position(_random), _size(_random) * 4.0f, _size(_random) * 4.0f);
+		_query.Point = Vec2(_position(_random), _position(_random));
+		const float _theta = _angle(_random);
+		_query.Direction = Vec2(std::cos(_theta), std::sin(_theta));
+	}
+
+	const Backend _backends[] = {
+		{ "quadtree", BroadphaseType::QuadTree },
+		{ "dynamic-tree", BroadphaseType::DynamicTree },
+		{ "sweep-and-prune", BroadphaseType::SweepAndPrune },
+		{ "spatial-hash", BroadphaseType::SpatialHash },
+	};
+
+	std::printf("%zu entities in a %.0fx%.0f world, ms per %zu queries, best of %d\n", EntityCount, WorldSize, WorldSize, QueryCount, Runs);
+	std::printf("  %-16s %7s %7s %8s %12s %8s  %s\n", "backend", "rect", "circle", "raycast", "raycast-all", "nearest", "matches");
+	std::vector<EntityHandle> _found;
+	std::vector<RaycastHit> _hits;
+	size_t _checksum = 0;
+	for (const Backend& _backend : _backends) {
+		BroadphaseConfig _config = _physics.GetBroadphaseConfig();
+		_config.Type = _backend.Type;
+		_physics.SetBroadphase(_config);
+		// The first step brings queued entities into the world; the next one gathers their proxies.
+		_scene.Step();
+		_scene.Step();
+
+		const double _rect = Bench::BestMilliseconds(Runs, [&]() {
+			for (const Query& _query : _queries) {
+				_found.clear();
+				_physics.QueryRect(_query.Range, QueryLayers, _found);
+				_checksum += _found.size();
+			}
+		});
+		const double _circle = Bench::BestMilliseconds(Runs, [&]() {
+			for (const Query& _query : _queries) {
+				_found.clear();
+				_physics.QueryCircle(_query.Point, CircleRadius, QueryLayers, _found);
+				_checksum += _found.size();
+			}
+		});
+		const double _raycast = Bench::BestMilliseconds(Runs, [&]() {
+			RaycastHit _hit;
+			for (const Query& _query : _queries) {
+				_checksum += _physics.Raycast(_query.Point, _query.Direction, RayLength, QueryLayers, _hit) ? 1 : 0;
+			}
+		});
+		const double _raycastAll = Bench::BestMilliseconds(Runs, [&]() {
+			for (const Query& _query : _queries) {
+				_hits.clear();
+				_physics.RaycastAll(_query.Point, _query.Direction, RayLength, QueryLayers, _hits);
+				_checksum += _hits.size();
+			}
+		});
+		const double _nearest = Bench::BestMilliseconds(Runs, [&]() {
+			for (const Query& _query : _queries) {
+				_checksum += _physics.FindNearest(_query.Point, QueryLayers).Index;
+			}
+		});
+
+		std::printf("  %-16s %7.2f %7.2f %8.2f %12.2f %8.2f  %s\n", _backend.Name, _rect, _circle, _raycast, _raycastAll, _nearest,
+			MatchesBruteForce(_physics, _queries) ? "yes" : "NO");
+	}
+	std::printf("checksum %zu\n", _checksum);
+	return 0;
+}
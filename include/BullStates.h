@@ -1,7 +1,9 @@
 #pragma once
 #include <core/State.h>
+#include <core/engine/ServiceRef.h>
 
 class BullComponent;
+class RunnerService;
 
 class BullState :
 	public State
@@ -28,6 +30,7 @@ private:
 	//timestamp
 	float LastShot;
 	float ShootFrequency = 1.3f;
+	ServiceRef<RunnerService> Runner;
 public:
 	BullDefaultState(BullComponent& _bull);
 	~BullDefaultState();
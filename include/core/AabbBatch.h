@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <core/Rect.h>
+#include <core/Entity.h>
+
+// Boxes stored as parallel min/max arrays so one query box can be tested against a run of
+// candidates with a single vector compare per axis.
+struct AabbSoA
+{
+	std::vector<float> MinX;
+	std::vector<float> MinY;
+	std::vector<float> MaxX;
+	std::vector<float> MaxY;
+	std::vector<CollisionLayerMask> Layers;
+
+	size_t Size() const { return MinX.size(); }
+
+	void Clear()
+	{
+		MinX.clear();
+		MinY.clear();
+		MaxX.clear();
+		MaxY.clear();
+		Layers.clear();
+	}
+
+	void Push(const Rectf& _bounds, CollisionLayerMask _layers)
+	{
+		MinX.push_back(_bounds.Left());
+		MinY.push_back(_bounds.Top());
+		MaxX.push_back(_bounds.Right());
+		MaxY.push_back(_bounds.Bottom());
+		Layers.push_back(_layers);
+	}
+};
+
+namespace AabbBatch {
+	enum class SimdLevel
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		AVX512,
+	};
+
+	// Run length ForEachOverlap hands to Overlap at a time, sized for a stack hit buffer.
+	constexpr size_t MaxBatch = 64;
+
+	// Widest level this CPU supports, detected once.
+	SimdLevel GetSupportedLevel();
+	SimdLevel GetActiveLevel();
+	// Clamped to the supported level. Meant for benchmarking and debugging.
+	void SetActiveLevel(SimdLevel _level);
+	const char* GetLevelName(SimdLevel _level);
+
+	// Tests `_query` against boxes [_first, _first + _count) with the same strict test as
+	// Rect::Intersects; boxes must also share a layer with `_layerMask`. Writes the offsets
+	// from `_first` of the hits to `_hits`, which needs room for `_count`, and returns how
+	// many there were.
+	size_t Overlap(const Rectf& _query, CollisionLayerMask _layerMask, const AabbSoA& _boxes,
+		size_t _first, size_t _count, uint32_t* _hits);
+
+	// Calls `_visit(index)` for every box in [_first, _first + _count) that overlaps `_query`.
+	template<typename Visitor>
+	void ForEachOverlap(const Rectf& _query, CollisionLayerMask _layerMask, const AabbSoA& _boxes,
+		size_t _first, size_t _count, Visitor&& _visit)
+	{
+		uint32_t _hits[MaxBatch];
+		const size_t _end = _first + _count;
+		for (size_t _begin = _first; _begin < _end; _begin += MaxBatch) {
+			const size_t _run = _end - _begin < MaxBatch ? _end - _begin : MaxBatch;
+			const size_t _found = Overlap(_query, _layerMask, _boxes, _begin, _run, _hits);
+			for (size_t _hit = 0; _hit < _found; ++_hit) {
+				_visit(_begin + _hits[_hit]);
+			}
+		}
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <core/Rect.h>
+#include <core/Entity.h>
+#include <core/EntityHandle.h>
+
+enum class BroadphaseType
+{
+	// Rebuilt from scratch every tick; cheap to build, bounded by the world bounds.
+	QuadTree,
+	// Persistent proxies with fat bounds; only entities that leave them are re-inserted.
+	DynamicTree,
+	// Boxes kept sorted on x by insertion sort, which is near-linear when little moves.
+	SweepAndPrune,
+	// Uniform grid hashed into buckets; best when boxes are similar in size to a cell.
+	SpatialHash,
+};
+
+struct BroadphaseConfig
+{
+	BroadphaseType Type = BroadphaseType::QuadTree;
+	int QuadTreeCapacity = 6;
+	int QuadTreeMaxDepth = 6;
+	float FatBoundsMargin = 4.0f;
+	float CellSize = 64.0f;
+};
+
+// One collidable entity for the current tick.
+struct BroadphaseProxy
+{
+	EntityHandle Handle;
+	Rectf Bounds;
+	CollisionLayerMask Layers = 0;
+	// Layers this proxy interacts with, already resolved through the collision matrix.
+	CollisionLayerMask CollidesWith = 0;
+};
+
+// Candidate pair, reported once with First.Index < Second.Index.
+struct BroadphasePair
+{
+	EntityHandle First;
+	EntityHandle Second;
+
+	bool operator<(const BroadphasePair& _other) const
+	{
+		return First.Index != _other.First.Index ? First.Index < _other.First.Index : Second.Index < _other.Second.Index;
+	}
+};
+
+class IBroadphase
+{
+public:
+	virtual ~IBroadphase() = default;
+
+	// Replaces the tracked set with this tick's proxies. Backends may keep state between
+	// calls to exploit coherence, keyed by handle.
+	virtual void Update(const std::vector<BroadphaseProxy>& _proxies) = 0;
+	// Appends every proxy on one of `_layerMask`'s layers whose bounds may overlap `_range`.
+	virtual void Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const = 0;
+	// Number of tracked proxies, in the backend's own order, that pair searches are split over.
+	virtual size_t GetProxyCount() const = 0;
+	// Appends the pairs owned by proxies [_begin, _end): pairs whose layers interact and whose
+	// bounds, as passed to Update, overlap. Every pair has exactly one owner, and disjoint
+	// ranges may be searched from different threads at once.
+	virtual void FindPairsInRange(size_t _begin, size_t _end, std::vector<BroadphasePair>& _pairs) const = 0;
+	virtual void Clear() = 0;
+
+	void FindPairs(std::vector<BroadphasePair>& _pairs) const { FindPairsInRange(0, GetProxyCount(), _pairs); }
+
+protected:
+	// Pair search built on Query, for backends without a cheaper native sweep.
+	void FindPairsByQuery(const std::vector<BroadphaseProxy>& _proxies, size_t _begin, size_t _end,
+		std::vector<BroadphasePair>& _pairs) const;
+};
+
+std::unique_ptr<IBroadphase> CreateBroadphase(const BroadphaseConfig& _config, const Rectf& _worldBounds);
+
+struct BroadphaseTiming
+{
+	BroadphaseType Type;
+	double MillisecondsPerFrame;
+	size_t PairsPerFrame;
+};
+
+// Replays a recorded distribution through every backend: each frame jitters the boxes by
+// up to `_jitter` pixels, updates the backend and finds all pairs. Results are sorted
+// fastest first, so front().Type is the backend to pick for scenes like this one.
+std::vector<BroadphaseTiming> BenchmarkBroadphases(const std::vector<BroadphaseProxy>& _recorded,
+	const BroadphaseConfig& _baseConfig, const Rectf& _worldBounds, int _frames = 60, float _jitter = 2.0f);
@@ -1,7 +1,12 @@
 #pragma once
+#include <cstdint>
+
 class Entity;
 class GameServiceHost;
 
+using ComponentTypeId = uint32_t;
+constexpr ComponentTypeId InvalidComponentTypeId = static_cast<ComponentTypeId>(-1);
+
 class Component
 {
 protected:
@@ -13,9 +18,24 @@ public:
 	~Component();
 
 	GameServiceHost& GetContext() { return Context; }
+	bool	IsActive() const { return Active; }
+	ComponentTypeId	GetTypeId() const { return TypeId; }
 
 	virtual void	Start();
 	virtual void	Update();
 	virtual void	PostUpdate();
-	virtual void	OnCollide(Entity& _other);
+	// Contact events from PhysicsService: Enter on the first overlapping tick, Stay on each
+	// following one, Exit once the pair stops overlapping or either side is disabled.
+	virtual void	OnCollisionEnter(Entity& _other);
+	virtual void	OnCollisionStay(Entity& _other);
+	virtual void	OnCollisionExit(Entity& _other);
+	virtual void	OnDisable();
+
+private:
+	friend class Entity;
+	friend class World;
+	ComponentTypeId	TypeId = InvalidComponentTypeId;
+	//positions in World's per-phase dispatch lists
+	uint32_t	UpdateSlot = 0;
+	uint32_t	PostUpdateSlot = 0;
 };
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <core/ComponentType.h>
 #include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 
 class Component;
@@ -15,11 +17,30 @@ class ComponentRegistry
 public:
 	using Factory = std::function<std::unique_ptr<Component>(Entity&, GameServiceHost&, std::string_view)>;
 
-	void Register(std::string_view type, Factory factory);
-	const Factory* Find(std::string_view type) const;
+	struct Registration
+	{
+		ComponentTypeId TypeId = InvalidComponentTypeId;
+		Factory Create;
+	};
+
+	// The component type is deduced from the factory's return type so its id can be assigned here.
+	template <typename Fn>
+	void Register(std::string_view type, Fn factory);
+	const Registration* Find(std::string_view type) const;
 	bool Contains(std::string_view type) const;
 	size_t Count() const;
 
 private:
-	std::unordered_map<std::string, Factory> Factories;
+	void Register(std::string_view type, ComponentTypeId typeId, Factory factory);
+
+	std::unordered_map<std::string, Registration> Factories;
 };
+
+template <typename Fn>
+void ComponentRegistry::Register(std::string_view type, Fn factory)
+{
+	using Created = std::invoke_result_t<Fn&, Entity&, GameServiceHost&, std::string_view>;
+	using Comp = typename Created::element_type;
+	static_assert(std::is_base_of<Component, Comp>::value, "Factory must return a std::unique_ptr to a Component type");
+	Register(type, ComponentType::Of<Comp>(), Factory(std::move(factory)));
+}
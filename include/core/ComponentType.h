@@ -0,0 +1,117 @@
+#pragma once
+
+#include <core/Component.h>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+constexpr size_t MaxComponentTypes = 32;
+
+using ComponentMask = std::bitset<MaxComponentTypes>;
+
+enum ComponentPhase : uint32_t
+{
+	ComponentPhaseNone = 0,
+	ComponentPhaseUpdate = 1u << 0,
+	ComponentPhasePostUpdate = 1u << 1,
+	ComponentPhaseCollisionEnter = 1u << 2,
+	ComponentPhaseCollisionStay = 1u << 3,
+	ComponentPhaseCollisionExit = 1u << 4,
+};
+
+// Runs one phase over a batch of components of a single concrete type.
+using ComponentBatchFn = void(*)(Component* const* components, size_t count);
+
+struct ComponentTypeInfo
+{
+	uint32_t Phases = ComponentPhaseNone;
+	ComponentBatchFn UpdateBatch = nullptr;
+	ComponentBatchFn PostUpdateBatch = nullptr;
+	// Batches may be split across job workers; see ComponentType::HasParallelUpdate.
+	bool ParallelUpdate = false;
+	// sizeof the concrete type, for memory accounting.
+	size_t Size = 0;
+};
+
+namespace ComponentType
+{
+	// Ids are dense and handed out in first-use order, so they are only stable within a run.
+	ComponentTypeId Register(const ComponentTypeInfo& info);
+	const ComponentTypeInfo& GetInfo(ComponentTypeId id);
+
+	// Qualified calls bind statically, so a batch runs without virtual dispatch.
+	template <typename T>
+	void UpdateBatch(Component* const* components, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			T* component = static_cast<T*>(components[i]);
+			if (component->IsActive()) {
+				component->T::Update();
+			}
+		}
+	}
+
+	template <typename T>
+	void PostUpdateBatch(Component* const* components, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			T* component = static_cast<T*>(components[i]);
+			if (component->IsActive()) {
+				component->T::PostUpdate();
+			}
+		}
+	}
+
+	// Opt-in for types whose Update/PostUpdate only touch their own entity and defer
+	// structural changes through JobService::Defer:
+	//     static constexpr bool ParallelUpdate = true;
+	template <typename T, typename = void>
+	struct HasParallelUpdate : std::false_type {};
+
+	template <typename T>
+	struct HasParallelUpdate<T, std::void_t<decltype(T::ParallelUpdate)>> : std::bool_constant<T::ParallelUpdate> {};
+
+	// A phase participates only if T (or a base between it and Component) overrides the hook.
+	template <typename T>
+	ComponentTypeInfo Describe()
+	{
+		static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+		ComponentTypeInfo info;
+		if (!std::is_same<decltype(&T::Update), void (Component::*)()>::value) {
+			info.Phases |= ComponentPhaseUpdate;
+			info.UpdateBatch = &UpdateBatch<T>;
+		}
+		if (!std::is_same<decltype(&T::PostUpdate), void (Component::*)()>::value) {
+			info.Phases |= ComponentPhasePostUpdate;
+			info.PostUpdateBatch = &PostUpdateBatch<T>;
+		}
+		if (!std::is_same<decltype(&T::OnCollisionEnter), void (Component::*)(Entity&)>::value) {
+			info.Phases |= ComponentPhaseCollisionEnter;
+		}
+		if (!std::is_same<decltype(&T::OnCollisionStay), void (Component::*)(Entity&)>::value) {
+			info.Phases |= ComponentPhaseCollisionStay;
+		}
+		if (!std::is_same<decltype(&T::OnCollisionExit), void (Component::*)(Entity&)>::value) {
+			info.Phases |= ComponentPhaseCollisionExit;
+		}
+		info.ParallelUpdate = HasParallelUpdate<T>::value;
+		info.Size = sizeof(T);
+		return info;
+	}
+
+	template <typename T>
+	ComponentTypeId Of()
+	{
+		static const ComponentTypeId id = Register(Describe<T>());
+		return id;
+	}
+
+	template <typename... Ts>
+	ComponentMask MaskOf()
+	{
+		ComponentMask mask;
+		(mask.set(Of<Ts>()), ...);
+		return mask;
+	}
+}
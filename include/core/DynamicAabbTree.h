@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <core/Rect.h>
+#include <core/Entity.h>
+#include <core/EntityHandle.h>
+
+// Incrementally updated bounding-volume hierarchy. Leaves store "fat" bounds enlarged by a
+// margin, so a proxy is only re-inserted once its entity leaves them; insertions pick the
+// cheapest sibling by perimeter and tree rotations keep the height logarithmic.
+class DynamicAabbTree
+{
+public:
+	static constexpr int32_t NullNode = -1;
+
+	explicit DynamicAabbTree(float _margin = 4.0f);
+
+	int32_t CreateProxy(const Rectf& _bounds, EntityHandle _entity, CollisionLayerMask _layers);
+	void DestroyProxy(int32_t _proxy);
+	// Returns true if the proxy had to be re-inserted.
+	bool MoveProxy(int32_t _proxy, const Rectf& _bounds);
+	void SetProxyLayers(int32_t _proxy, CollisionLayerMask _layers);
+	void Clear();
+
+	// Candidates are returned by fat bounds; callers run their own exact test.
+	void Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const;
+
+	EntityHandle GetProxyEntity(int32_t _proxy) const { return Nodes[_proxy].Entity; }
+	CollisionLayerMask GetProxyLayers(int32_t _proxy) const { return Nodes[_proxy].Layers; }
+	const Rectf& GetFatBounds(int32_t _proxy) const { return Nodes[_proxy].Bounds; }
+	int32_t GetHeight() const { return Root == NullNode ? 0 : Nodes[Root].Height; }
+	float GetMargin() const { return Margin; }
+	void SetMargin(float _margin) { Margin = _margin; }
+
+private:
+	struct Node
+	{
+		Rectf Bounds;
+		EntityHandle Entity;
+		// Leaves: the proxy's layers. Internal nodes: union of the subtree, for pruning queries.
+		CollisionLayerMask Layers = 0;
+		int32_t Parent = NullNode;	// doubles as the free-list link
+		int32_t Child1 = NullNode;
+		int32_t Child2 = NullNode;
+		int32_t Height = 0;			// leaf = 0, free = -1
+
+		bool IsLeaf() const { return Child1 == NullNode; }
+	};
+
+	int32_t AllocateNode();
+	void FreeNode(int32_t _node);
+	void InsertLeaf(int32_t _leaf);
+	void RemoveLeaf(int32_t _leaf);
+	void RefitAncestors(int32_t _node);
+	void Refit(int32_t _node);
+	int32_t Balance(int32_t _node);
+
+	std::vector<Node> Nodes;
+	int32_t Root = NullNode;
+	int32_t FreeList = NullNode;
+	float Margin;
+};
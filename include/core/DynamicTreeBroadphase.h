@@ -0,0 +1,33 @@
+#pragma once
+#include <core/Broadphase.h>
+#include <core/DynamicAabbTree.h>
+
+class DynamicTreeBroadphase final : public IBroadphase
+{
+public:
+	explicit DynamicTreeBroadphase(float _margin);
+
+	void Update(const std::vector<BroadphaseProxy>& _proxies) override;
+	void Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const override;
+	size_t GetProxyCount() const override { return Proxies.size(); }
+	void FindPairsInRange(size_t _begin, size_t _end, std::vector<BroadphasePair>& _pairs) const override;
+	void Clear() override;
+
+	const DynamicAabbTree& GetTree() const { return Tree; }
+
+private:
+	// Tree leaf per entity, indexed by handle index.
+	struct TreeProxy
+	{
+		int32_t Node = DynamicAabbTree::NullNode;
+		uint32_t Generation = 0;
+		uint32_t LastSync = 0;
+		// Position in Proxies as of the last Update.
+		uint32_t Proxy = 0;
+	};
+
+	DynamicAabbTree Tree;
+	std::vector<TreeProxy> Slots;
+	std::vector<BroadphaseProxy> Proxies;
+	uint32_t SyncStamp = 0;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <SDL3/SDL.h>
+#include <array>
 #include <string>
 #include <vector>
 #include <core/Vec2.h>
@@ -7,9 +8,12 @@
 #include <core/Sprite.h>
 #include <core/animation/AnimationStateMachine.h>
 #include <core/Component.h>
+#include <core/ComponentType.h>
+#include <core/EntityHandle.h>
 
 class GameServiceHost;
 class Camera;
+class World;
 
 enum ENTITY_TAG {
 	player = 0,
@@ -19,45 +23,101 @@ enum ENTITY_TAG {
 	pickup
 };
 
+//collision layers: by default an entity sits on the layer of its tag
+using CollisionLayerMask = uint32_t;
+constexpr size_t MaxCollisionLayers = 32;
+constexpr CollisionLayerMask LayerOf(ENTITY_TAG _tag) { return 1u << _tag; }
+
+enum class CollisionEvent
+{
+	Enter,
+	Stay,
+	Exit,
+};
+
+//told when an entity it tracks is disabled, e.g. so a pool can hand it out again
+class EntityReleaseListener
+{
+public:
+	virtual void		OnEntityReleased(Entity& _entity, uint32_t _ticket) = 0;
+
+protected:
+	~EntityReleaseListener() = default;
+};
+
 class Entity
 {
 protected:
 	Vec2				Position;
+	//position at the start of the current step, for render interpolation
+	Vec2				PreviousPosition;
 	Vec2				Direction;
 
 	Sprite				Sprite;
 
 	std::vector<std::unique_ptr<Component>> Components;
+	std::array<Component*, MaxComponentTypes> ComponentSlots;
+	ComponentMask		ComponentTypes;
+	//components per contact event, so e.g. stay ticks skip components that only want enter
+	std::vector<Component*>	CollisionEnterListeners;
+	std::vector<Component*>	CollisionStayListeners;
+	std::vector<Component*>	CollisionExitListeners;
 
 	ENTITY_TAG			Tag;
+	CollisionLayerMask	CollisionLayers;
+	//never moves on its own; collision detection keeps it with the sleeping bodies
+	bool				Static;
 	bool				Activated;
 
 	std::unique_ptr<AnimationStateMachine>	Animator;
 	GameServiceHost&					Services;
 
+private:
+	friend class World;
+	World*				OwnerWorld = nullptr;
+	EntityHandle		Handle;
+	size_t				WorldSlot = 0;
+	bool				StateChangePending = false;
+	bool				DestroyPending = false;
+	EntityReleaseListener*	ReleaseListener = nullptr;
+	uint32_t			ReleaseTicket = 0;
+
 public:
 	Entity(GameServiceHost& _services, std::string _texture, float _width, float _height);
 	~Entity();
 
 	typedef std::unique_ptr<Entity> Ptr;
 
-	void			AttachComponent(std::unique_ptr<Component> _comp);
+	void			AttachComponent(std::unique_ptr<Component> _comp, ComponentTypeId _typeId);
+
+	template <typename Comp>
+	Comp*	AttachComponent(std::unique_ptr<Comp> _comp);
 
 	template <typename Comp>
 	Comp*	GetComponent();
 
+	template <typename... Comps>
+	bool	HasComponents() const;
+
 	virtual void		Start();
 	virtual void		Update();
 	virtual void		PostUpdate();
-	void				Render(SDL_Renderer* _renderer, Camera* _camera = nullptr);
+	//_alpha blends from the previous step's position (0) to the current one (1)
+	void				Render(SDL_Renderer* _renderer, Camera* _camera = nullptr, float _alpha = 1.0f);
 
 	void				StartComponents();
 	void				UpdateComponents();
 	void				PostUpdateComponents();
+	void				UpdateAnimator();
 
-	void				SetTag(ENTITY_TAG _tag) { Tag = _tag; }
-	void				Enable() { Activated = true; Start(); }
-	void				Disable() { Activated = false; }
+	//also moves the entity onto the tag's layer; call SetCollisionLayers afterwards to override
+	void				SetTag(ENTITY_TAG _tag) { Tag = _tag; CollisionLayers = LayerOf(_tag); }
+	void				SetCollisionLayers(CollisionLayerMask _layers) { CollisionLayers = _layers; }
+	void				SetStatic(bool _static) { Static = _static; }
+	void				Enable();
+	//Disable also notifies the release listener, passing back _ticket; nullptr detaches
+	void				Disable();
+	void				SetReleaseListener(EntityReleaseListener* _listener, uint32_t _ticket) { ReleaseListener = _listener; ReleaseTicket = _ticket; }
 
 	void				SetPosition(float _x, float _y);
 	void				SetPosition(Vec2 _pos);
@@ -67,12 +127,20 @@ public:
 	void				AssignAnimator(std::unique_ptr<AnimationStateMachine> _animator);
 
 	ENTITY_TAG			GetTag() const { return Tag; }
+	CollisionLayerMask	GetCollisionLayers() const { return CollisionLayers; }
 	AnimationStateMachine*	GetAnimator() { return Animator.get(); }
 	const AnimationStateMachine*	GetAnimator() const { return Animator.get(); }
 	bool				IsEnabled() const { return Activated; }
-	void				OnCollide(Entity& _other);
+	bool				IsStatic() const { return Static; }
+	EntityHandle		GetHandle() const { return Handle; }
+	void				OnCollisionEnter(Entity& _other);
+	void				OnCollisionStay(Entity& _other);
+	void				OnCollisionExit(Entity& _other);
 
 	Vec2				GetPosition() const { return Position; }
+	Vec2				GetInterpolatedPosition(float _alpha) const { return _alpha < 1.0f ? PreviousPosition + (Position - PreviousPosition) * _alpha : Position; }
+	//call after teleporting so rendering doesn't sweep across the gap
+	void				SnapInterpolation() { PreviousPosition = Position; }
 	Vec2				GetDirection() const { return Direction; }
 	Rectf				GetBoundingRect() const { return Sprite.GetGlobalBounds(); }
 	bool				Collision(const Entity* _entity) const { return _entity->GetBoundingRect().Intersects(GetBoundingRect()); }
@@ -82,14 +150,38 @@ public:
 	GameServiceHost&		GetServices() { return Services; }
 	float				GetWidth() const { return Sprite.GetGlobalBounds().w; }
 	float				GetHeight() const { return Sprite.GetGlobalBounds().h; }
+	//bytes owned by this entity and its components; shared textures and masks aren't counted
+	size_t				GetMemoryFootprint() const;
+	bool				IsDestroyPending() const { return DestroyPending; }
+};
+
+// Contiguous view over a slice of entity storage, e.g. World's active range.
+struct EntityRange
+{
+	const Entity::Ptr*			First;
+	const Entity::Ptr*			Last;
+
+	const Entity::Ptr*			begin() const { return First; }
+	const Entity::Ptr*			end() const { return Last; }
+	size_t						size() const { return static_cast<size_t>(Last - First); }
+	bool						empty() const { return First == Last; }
 };
 
 template<typename Comp>
-Comp* Entity::GetComponent() {
-	Comp* _result = nullptr;
-	for (auto& _component : Components) {
-		_result = dynamic_cast<Comp*>(_component.get());
-		if (_result) break;
-	}
+Comp* Entity::AttachComponent(std::unique_ptr<Comp> _comp) {
+	Comp* _result = _comp.get();
+	AttachComponent(std::move(_comp), ComponentType::Of<Comp>());
 	return _result;
 }
+
+//lookup is by exact type: a slot holds the first component attached with that type id
+template<typename Comp>
+Comp* Entity::GetComponent() {
+	return static_cast<Comp*>(ComponentSlots[ComponentType::Of<Comp>()]);
+}
+
+template<typename... Comps>
+bool Entity::HasComponents() const {
+	static const ComponentMask _required = ComponentType::MaskOf<Comps...>();
+	return (ComponentTypes & _required) == _required;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+// Weak reference to an entity owned by a World: an index into the world's handle table
+// plus the generation that slot had when the handle was issued. Once the entity is
+// destroyed the slot's generation moves on and the handle resolves to nullptr.
+struct EntityHandle
+{
+	static constexpr uint32_t InvalidIndex = static_cast<uint32_t>(-1);
+
+	uint32_t	Index = InvalidIndex;
+	uint32_t	Generation = 0;
+
+	bool		IsValid() const { return Index != InvalidIndex; }
+
+	bool		operator==(const EntityHandle& _other) const { return Index == _other.Index && Generation == _other.Generation; }
+	bool		operator!=(const EntityHandle& _other) const { return !(*this == _other); }
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <vector>
+#include <core/Rect.h>
+
+class Sprite;
+
+// 1-bit alpha mask of a whole texture, packed 64 pixels to a word with each row starting on
+// a new word, so an animation frame is just a rect into it. A mirrored copy is kept so a
+// horizontally flipped frame reads 64 pixels at a time the same way.
+class PixelMask
+{
+public:
+	// A texture rect of a mask placed in the world with its top-left pixel at (X, Y).
+	struct Placement
+	{
+		const PixelMask*	Mask;
+		Recti				Frame;
+		bool				FlipX;
+		int					X;
+		int					Y;
+	};
+
+	// Pixels with at least `_alphaThreshold` alpha are solid. Empty if the surface can't be read.
+	static PixelMask FromSurface(SDL_Surface* _surface, uint8_t _alphaThreshold);
+
+	// Whether the two placements share a solid pixel, ANDing one 64-pixel run per step.
+	static bool Overlap(const Placement& _a, const Placement& _b);
+	// Overlap for the sprites' current frames and flip state. If either sprite has no mask
+	// the pair stays an AABB test and this returns true.
+	static bool SpritesOverlap(const Sprite& _a, const Sprite& _b);
+
+	int				GetWidth() const { return Width; }
+	int				GetHeight() const { return Height; }
+	bool			IsEmpty() const { return Bits.empty(); }
+	bool			IsSolid(int _x, int _y) const { return (GetRow64(_x, _y, false) & 1u) != 0; }
+	// Pixels [_x, _x + 64) of row `_y`, bit i being column _x + i; zero outside the texture.
+	uint64_t		GetRow64(int _x, int _y, bool _mirrored) const;
+
+private:
+	int						Width = 0;
+	int						Height = 0;
+	int						WordsPerRow = 0;
+	std::vector<uint64_t>	Bits;
+	std::vector<uint64_t>	MirroredBits;
+};
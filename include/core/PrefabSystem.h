@@ -2,6 +2,7 @@
 
 #include <core/ComponentRegistry.h>
 #include <core/Entity.h>
+#include <core/StringId.h>
 #include <core/Vec2.h>
 #include <memory>
 #include <string>
@@ -15,6 +16,8 @@ class ResourceHandler;
 struct AnimationDefinition
 {
 	std::string Name;
+	// Interned Name, as AnimationStateMachine keys it.
+	StringId Id;
 	int Index = 0;
 	Vec2 FrameSize = Vec2(0, 0);
 	int Frames = 0;
@@ -28,6 +31,18 @@ struct ComponentDefinition
 	std::string ParamsJson;
 };
 
+// "pool": {"initial": N, "max": M, "growth": G}. ObjectPoolService::PrewarmPools builds
+// declared pools up front instead of on the first fetch.
+struct PoolDefinition
+{
+	bool Declared = false;
+	size_t Initial = 0;
+	// 0 means no limit. A pool still grows past its max, but logs it.
+	size_t Max = 0;
+	// Size multiplier applied when the pool runs dry.
+	float Growth = 2.0f;
+};
+
 struct PrefabDefinition
 {
 	std::string Id;
@@ -36,8 +51,22 @@ struct PrefabDefinition
 	float Height = 0.0f;
 	Vec2 Position = Vec2(0, 0);
 	ENTITY_TAG Tag = player;
+	// 0 keeps the tag's own layer.
+	CollisionLayerMask CollisionLayers = 0;
+	// Level geometry and other bodies that never move; see Entity::SetStatic.
+	bool Static = false;
 	std::vector<AnimationDefinition> Animations;
 	std::vector<ComponentDefinition> Components;
+	PoolDefinition Pool;
+};
+
+// A row for PhysicsService's collision response table; the handler is looked up by name.
+struct CollisionResponseDefinition
+{
+	ENTITY_TAG Self = player;
+	ENTITY_TAG Other = player;
+	CollisionEvent Event = CollisionEvent::Enter;
+	std::string Handler;
 };
 
 class PrefabSystem
@@ -51,17 +80,25 @@ public:
 	bool LoadFromFile(const std::string& path);
 	bool LoadFromFile(const std::string& path, ResourceHandler& textures);
 
+	const PrefabDefinition* Find(StringId id) const;
 	const PrefabDefinition* Find(std::string_view id) const;
+	std::vector<const PrefabDefinition*> GetDefinitions() const;
 
 	std::unique_ptr<Entity> Instantiate(std::string_view id) const;
 	std::unique_ptr<Entity> Instantiate(const PrefabDefinition& definition) const;
 
+	// Rows from the file's optional top-level "collisionResponses", added on top of the
+	// game's default table.
+	const std::vector<CollisionResponseDefinition>& GetCollisionResponses() const { return CollisionResponses; }
+
 	std::vector<std::string> GetTexturePaths() const;
 	size_t Count() const;
 	void Clear();
 
 private:
 	ComponentRegistry Registry;
-	std::unordered_map<std::string, PrefabDefinition> Definitions;
+	// Keyed by the interned Id.
+	std::unordered_map<StringId, PrefabDefinition> Definitions;
+	std::vector<CollisionResponseDefinition> CollisionResponses;
 	GameServiceHost* Services = nullptr;
 };
@@ -1,28 +1,71 @@
 #pragma once
-#include <array>
-#include <memory>
+#include <cstdint>
 #include <vector>
+#include <core/AabbBatch.h>
 #include <core/Rect.h>
 #include <core/Entity.h>
+#include <core/EntityHandle.h>
 
+// Flat quadtree rebuilt every tick. Nodes live in one array with index-based children and
+// each node owns a contiguous range of a shared item buffer. Clear() only resets sizes, so
+// after the first few frames building the tree allocates nothing. Built items are stored as
+// SoA bounds so a node's items are tested against a query in SIMD batches.
+//
+// Usage per frame: Clear(), Insert() every item, Build(), then Query() as often as needed.
 class QuadTree
 {
 public:
-	QuadTree(const Rectf& _bounds, int _capacity = 6, int _maxDepth = 6, int _depth = 0);
+	static constexpr int MaxDepthLimit = 16;
+
+	QuadTree(const Rectf& _bounds, int _capacity = 6, int _maxDepth = 6);
 
 	void Clear();
-	void Insert(Entity* _entity);
-	void Query(const Rectf& _range, std::vector<Entity*>& _found) const;
+	void Insert(EntityHandle _entity, const Rectf& _bounds, CollisionLayerMask _layers);
+	void Build();
+	// Only items on at least one of `_layerMask`'s layers are returned.
+	void Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const;
+
+	const Rectf& GetBounds() const { return Bounds; }
 
 private:
+	// Bounds are captured at insert time, so queries never touch entity storage.
+	struct Item
+	{
+		EntityHandle Handle;
+		Rectf Bounds;
+		CollisionLayerMask Layers;
+	};
+
+	struct Node
+	{
+		Rectf Bounds;
+		uint32_t FirstChild = 0;	// children are 4 consecutive nodes; 0 means leaf (root is never a child)
+		uint32_t ItemBegin = 0;
+		uint32_t ItemCount = 0;
+	};
+
+	// Range of Pending still to be distributed below a node.
+	struct BuildTask
+	{
+		uint32_t Node;
+		uint32_t Begin;
+		uint32_t End;
+		int Depth;
+	};
+
+	uint32_t Subdivide(uint32_t _node);
+	static bool ContainsRect(const Rectf& _outer, const Rectf& _inner);
+
 	Rectf Bounds;
 	int Capacity;
 	int MaxDepth;
-	int Depth;
-	std::vector<Entity*> Items;
-	std::array<std::unique_ptr<QuadTree>, 4> Children;
+	bool Built = false;
 
-	bool InsertIntoChild(Entity* _entity);
-	void Subdivide();
-	bool ContainsRect(const Rectf& _outer, const Rectf& _inner) const;
+	std::vector<Node> Nodes;
+	// Insert appends here unsorted; Build partitions it in place.
+	std::vector<Item> Pending;
+	// Items in node order after Build.
+	std::vector<EntityHandle> ItemHandles;
+	AabbSoA ItemBounds;
+	std::vector<BuildTask> Tasks;
 };
@@ -0,0 +1,19 @@
+#pragma once
+#include <core/Broadphase.h>
+#include <core/QuadTree.h>
+
+class QuadTreeBroadphase final : public IBroadphase
+{
+public:
+	QuadTreeBroadphase(const Rectf& _worldBounds, int _capacity, int _maxDepth);
+
+	void Update(const std::vector<BroadphaseProxy>& _proxies) override;
+	void Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const override;
+	size_t GetProxyCount() const override { return Proxies.size(); }
+	void FindPairsInRange(size_t _begin, size_t _end, std::vector<BroadphasePair>& _pairs) const override;
+	void Clear() override;
+
+private:
+	QuadTree Tree;
+	std::vector<BroadphaseProxy> Proxies;
+};
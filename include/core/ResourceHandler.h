@@ -1,8 +1,11 @@
 #pragma once
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
-#include <map>
+#include <core/PixelMask.h>
+#include <core/StringId.h>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <memory>
 #include <stdexcept>
 #include <cassert>
@@ -14,10 +17,19 @@ public:
 	~ResourceHandler();
 
 	void					Load(const std::string& _filename);
-	SDL_Texture*			Get(const std::string& _filename);
+	SDL_Texture*			Get(StringId _filename);
+	SDL_Texture*			Get(std::string_view _filename);
+	//alpha mask built when the texture was loaded, or nullptr
+	const PixelMask*		GetMask(StringId _filename) const;
+	const PixelMask*		GetMask(std::string_view _filename) const;
 	void					Flush();
 
+	//pixels at least this opaque are solid in the collision mask
+	static constexpr uint8_t MaskAlphaThreshold = 128;
+
 private:
 	SDL_Renderer* Renderer;
-	std::map<std::string, SDL_Texture*> Resources;
+	//keyed by the interned file name
+	std::unordered_map<StringId, SDL_Texture*> Resources;
+	std::unordered_map<StringId, PixelMask> Masks;
 };
@@ -0,0 +1,46 @@
+#pragma once
+#include <core/Broadphase.h>
+
+// Uniform grid of `CellSize` cells hashed into a bucket array rebuilt every tick with a
+// counting sort, so the grid is unbounded and allocation stops once capacities settle.
+class SpatialHashBroadphase final : public IBroadphase
+{
+public:
+	explicit SpatialHashBroadphase(float _cellSize);
+
+	void Update(const std::vector<BroadphaseProxy>& _proxies) override;
+	void Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const override;
+	size_t GetProxyCount() const override { return Proxies.size(); }
+	void FindPairsInRange(size_t _begin, size_t _end, std::vector<BroadphasePair>& _pairs) const override;
+	void Clear() override;
+
+	float GetCellSize() const { return CellSize; }
+
+private:
+	struct CellRange
+	{
+		int32_t MinX;
+		int32_t MinY;
+		int32_t MaxX;
+		int32_t MaxY;
+	};
+
+	// Buckets mix cells, so entries remember which cell they were filed under.
+	struct CellEntry
+	{
+		int32_t CellX;
+		int32_t CellY;
+		uint32_t Proxy;
+	};
+
+	CellRange CellsOf(const Rectf& _bounds) const;
+	uint32_t BucketOf(int32_t _cellX, int32_t _cellY) const;
+
+	float CellSize;
+	float InverseCellSize;
+	uint32_t BucketMask = 0;
+	std::vector<BroadphaseProxy> Proxies;
+	// Bucket b owns Entries[BucketStart[b], BucketStart[b + 1]).
+	std::vector<uint32_t> BucketStart;
+	std::vector<CellEntry> Entries;
+};
@@ -4,6 +4,7 @@
 #include <core/Rect.h>
 
 class Camera;
+class PixelMask;
 
 class Sprite {
 private:
@@ -12,6 +13,7 @@ private:
     Recti           SrcRect;
     bool            HasSrcRect;
     SDL_FlipMode    FlipMode;
+    const PixelMask* CollisionMask;
 
 public:
     Sprite();
@@ -22,9 +24,15 @@ public:
     void SetPosition(const Vec2& _pos);
     void SetPosition(float _x, float _y);
     void SetFlipX(bool _flip);
+    // Owned by ResourceHandler, like the texture.
+    void SetCollisionMask(const PixelMask* _mask) { CollisionMask = _mask; }
 
     SDL_Texture* GetTexture() const { return Texture; }
     const SDL_FRect& GetDestRect() const { return DestRect; }
+    const PixelMask* GetCollisionMask() const { return CollisionMask; }
+    // The part of the texture currently drawn, e.g. the animation frame.
+    Recti GetTextureRect() const;
+    bool IsFlippedX() const { return FlipMode == SDL_FLIP_HORIZONTAL; }
     Rectf GetGlobalBounds() const;
 
     void Render(SDL_Renderer* _renderer, Camera* _camera = nullptr);
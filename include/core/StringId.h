@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+// 64-bit FNV-1a hash of a name, so lookups by prefab, animation, state or texture name
+// compare and hash an integer instead of building a std::string. Literals hash at compile
+// time when the id is constexpr:
+//     constexpr StringId WalkAnimation("walk");
+// Intern also records the text, so an id can be turned back into its name for logs and tools.
+class StringId
+{
+public:
+	constexpr						StringId() = default;
+	constexpr explicit				StringId(std::string_view _name) : Value(Hash(_name)) {}
+
+	// Hashes `_name` and remembers its text; the same name always yields the same id.
+	static StringId					Intern(std::string_view _name);
+
+	static constexpr uint64_t		Hash(std::string_view _name)
+	{
+		uint64_t _hash = 14695981039346656037ull;
+		for (const char _c : _name) {
+			_hash ^= static_cast<uint8_t>(_c);
+			_hash *= 1099511628211ull;
+		}
+		return _hash;
+	}
+
+	// Empty unless the name was interned.
+	std::string_view				GetName() const;
+	constexpr uint64_t				GetValue() const { return Value; }
+	constexpr bool					IsValid() const { return Value != 0; }
+
+	constexpr bool					operator==(StringId _other) const { return Value == _other.Value; }
+	constexpr bool					operator!=(StringId _other) const { return Value != _other.Value; }
+	constexpr bool					operator<(StringId _other) const { return Value < _other.Value; }
+
+private:
+	uint64_t						Value = 0;
+};
+
+namespace std {
+	template <>
+	struct hash<StringId>
+	{
+		// Already a well mixed hash.
+		size_t operator()(StringId _id) const { return static_cast<size_t>(_id.GetValue()); }
+	};
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <core/AabbBatch.h>
+#include <core/Broadphase.h>
+
+// Sort-and-sweep on the x axis. The previous tick's order is kept and re-sorted with an
+// insertion sort, which costs close to O(n) when entities only move a little. The sorted
+// bounds are mirrored into SoA arrays so each sweep run is tested in SIMD batches.
+class SweepAndPruneBroadphase final : public IBroadphase
+{
+public:
+	void Update(const std::vector<BroadphaseProxy>& _proxies) override;
+	void Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const override;
+	size_t GetProxyCount() const override { return Entries.size(); }
+	void FindPairsInRange(size_t _begin, size_t _end, std::vector<BroadphasePair>& _pairs) const override;
+	void Clear() override;
+
+private:
+	struct Entry
+	{
+		float MinX;
+		Rectf Bounds;
+		EntityHandle Handle;
+		CollisionLayerMask Layers;
+		CollisionLayerMask CollidesWith;
+	};
+
+	static Entry MakeEntry(const BroadphaseProxy& _proxy);
+
+	// Sorted by MinX.
+	std::vector<Entry> Entries;
+	std::vector<Entry> Next;
+	// Entries' bounds and layers in the same order.
+	AabbSoA Boxes;
+	// Handle index -> position + 1 in the proxies being applied; all zero between updates.
+	std::vector<uint32_t> Lookup;
+	// Widest entry, which bounds how far left of a query range a match can start.
+	float MaxWidth = 0.0f;
+};
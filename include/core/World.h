@@ -1,9 +1,11 @@
 #pragma once
 #include <SDL3/SDL.h>
 #include <core/Entity.h>
+#include <core/ComponentType.h>
 #include <core/engine/GameServiceHost.h>
 #include <core/Sprite.h>
 #include <core/UI/UIManager.h>
+#include <array>
 #include <memory>
 
 class GameMode;
@@ -12,6 +14,20 @@ class World
 {
 private:
 	void						HandleQueue();
+	void						ApplyStateChanges();
+	void						ApplyDestroys();
+	void						SwapSlots(size_t _a, size_t _b);
+	void						LinkPhases(Entity& _entity);
+	void						UnlinkPhases(Entity& _entity);
+	void						AssignHandle(Entity& _entity);
+	void						ReleaseHandle(Entity& _entity);
+
+	// Smallest batch worth handing to a job worker.
+	static constexpr size_t		ParallelGrain = 64;
+
+	using PhaseLists = std::array<std::vector<Component*>, MaxComponentTypes>;
+	void						RunPhase(PhaseLists& _lists, ComponentBatchFn ComponentTypeInfo::* _batch);
+	void						UpdateAnimators();
 
 private:
 	GameServiceHost&			Services;
@@ -19,11 +35,28 @@ private:
 	Sprite						Background;
 	std::unique_ptr<UIManager>	UI;
 
+	// Partitioned: [0, ActiveCount) are enabled, the rest are disabled (mostly pooled) entities.
 	std::vector<Entity::Ptr>	Entities;
+	size_t						ActiveCount;
 	std::vector<Entity::Ptr>	AddQueue;
+	std::vector<Entity*>		PendingStateChanges;
+	std::vector<Entity*>		DestroyQueue;
+
+	// Components of active entities that override a phase, grouped by concrete type.
+	PhaseLists					UpdateLists;
+	PhaseLists					PostUpdateLists;
 
-	Entity*						CameraTarget;
-	void						UpdateCamera();
+	// Handle table: slot generations outlive the entities, so stale handles are detected on resolve.
+	struct HandleSlot
+	{
+		Entity*					Target = nullptr;
+		uint32_t				Generation = 0;
+	};
+	std::vector<HandleSlot>		HandleSlots;
+	std::vector<uint32_t>		FreeHandles;
+
+	EntityHandle				CameraTarget;
+	void						UpdateCamera(float _deltaTime, float _alpha);
 
 public:
 								World(GameServiceHost& _services);
@@ -31,12 +64,15 @@ public:
 
 	void						SetGameMode(GameMode* _mode);
 	void						AddObject(std::unique_ptr<Entity> _entity);
+	// Disables the entity now and frees it at the next sync point (the start of the next step),
+	// filling its slot with the last entity. Its release listener is dropped first.
+	void						DestroyObject(Entity& _entity);
 	void						ClearEntities();
 	void						Reset();
 	GameMode*					GetGameMode() const { return Mode; }
 	UIManager*					GetUI() const { return UI.get(); }
 	void						SetBackgroundTexture(SDL_Texture* _texture);
-	void						SetCameraTarget(Entity* _entity);
+	void						SetCameraTarget(EntityHandle _entity);
 
 	void						Init();
 	void						BuildScene();
@@ -45,6 +81,17 @@ public:
 	void						Update();
 	void						PostUpdate();
 
+	// Blends entity positions between the last two steps when the runner uses a fixed tick rate.
 	void						Render();
+	// Captures positions at the start of a step for render interpolation.
+	void						SavePreviousPositions();
 	const std::vector<Entity::Ptr>& GetEntities() const { return Entities; }
+	EntityRange					GetActiveEntities() const { return { Entities.data(), Entities.data() + ActiveCount }; }
+	size_t						GetActiveCount() const { return ActiveCount; }
+
+	// Returns nullptr once the entity behind the handle has been destroyed.
+	Entity*						Resolve(EntityHandle _handle) const;
+
+	// Called by Entity::Enable/Disable; the partition is fixed up at the next sync point, never mid-iteration.
+	void						NotifyStateChanged(Entity& _entity);
 };
@@ -1,16 +1,18 @@
 #pragma once
 #include <SDL3/SDL.h>
 #include <string>
-#include <map>
+#include <string_view>
+#include <unordered_map>
 
 #include <core/animation/Animation.h>
+#include <core/StringId.h>
 
 class AnimationStateMachine
 {
 protected:
 	Animation*						CurrentAnimation;
 	Animation*						PendingAnimation;
-	std::map<std::string, AnimPtr>	AnimationMap;
+	std::unordered_map<StringId, AnimPtr>	AnimationMap;
 	Uint64							LastAnimTime;
 	bool							ForceRestart;
 
@@ -21,7 +23,10 @@ public:
 	~AnimationStateMachine();
 
 	void Update(Sprite& _sprite);
-	void AddAnimation(const std::string& _name, AnimPtr _anim);
+	void AddAnimation(StringId _name, AnimPtr _anim);
+	void AddAnimation(std::string_view _name, AnimPtr _anim);
 	bool IsNextPriority();
-	void PlayAnimation(const std::string& _anim);
+	void PlayAnimation(StringId _anim);
+	//for tools and scripts; game code passes a constexpr StringId
+	void PlayAnimation(std::string_view _anim);
 };
@@ -2,13 +2,27 @@
 
 #include <core/engine/IService.h>
 #include <cassert>
+#include <cstddef>
 #include <stdexcept>
-#include <typeindex>
-#include <unordered_map>
+#include <string>
+#include <typeinfo>
 #include <vector>
 #include <memory>
 #include <utility>
 
+namespace ServiceType
+{
+	// Dense per-type slot index, assigned on first use.
+	size_t NextId();
+
+	template <typename T>
+	size_t Of()
+	{
+		static const size_t id = NextId();
+		return id;
+	}
+}
+
 class GameServiceHost
 {
 public:
@@ -26,6 +40,7 @@ public:
 
 	void Init();
 	void Update();
+	void FixedUpdate();
 	void Shutdown();
 
 private:
@@ -36,10 +51,12 @@ private:
 	};
 
 	std::vector<ServiceEntry> Services;
-	std::unordered_map<std::type_index, IService*> Registry;
+	// Indexed by ServiceType::Of<T>(); entries never move, so SortServices does not touch them.
+	std::vector<IService*> Slots;
 	bool Initialized = false;
 
 	void SortServices();
+	IService* FindSlot(size_t slot) const { return slot < Slots.size() ? Slots[slot] : nullptr; }
 };
 
 template <typename T, typename... Args>
@@ -49,9 +66,12 @@ T& GameServiceHost::AddService(int order, Args&&... args)
 	service->SetHost(this);
 	auto* rawService = service.get();
 
-	auto typeIndex = std::type_index(typeid(T));
-	assert(Registry.find(typeIndex) == Registry.end());
-	Registry.emplace(typeIndex, rawService);
+	const size_t slot = ServiceType::Of<T>();
+	if (slot >= Slots.size()) {
+		Slots.resize(slot + 1, nullptr);
+	}
+	assert(Slots[slot] == nullptr);
+	Slots[slot] = rawService;
 	Services.push_back({order, std::move(service)});
 
 	if (Initialized) {
@@ -66,27 +86,23 @@ template <typename T>
 T& GameServiceHost::Get() const
 {
 	static_assert(std::is_base_of<IService, T>::value, "T must derive from IService");
-	auto iter = Registry.find(std::type_index(typeid(T)));
-	if (iter == Registry.end()) {
+	IService* service = FindSlot(ServiceType::Of<T>());
+	if (!service) {
 		throw std::runtime_error("Service not registered: " + std::string(typeid(T).name()));
 	}
-	return *static_cast<T*>(iter->second);
+	return *static_cast<T*>(service);
 }
 
 template <typename T>
 T* GameServiceHost::TryGet() const
 {
 	static_assert(std::is_base_of<IService, T>::value, "T must derive from IService");
-	auto iter = Registry.find(std::type_index(typeid(T)));
-	if (iter == Registry.end()) {
-		return nullptr;
-	}
-	return static_cast<T*>(iter->second);
+	return static_cast<T*>(FindSlot(ServiceType::Of<T>()));
 }
 
 template <typename T>
 bool GameServiceHost::Has() const
 {
 	static_assert(std::is_base_of<IService, T>::value, "T must derive from IService");
-	return Registry.find(std::type_index(typeid(T))) != Registry.end();
+	return FindSlot(ServiceType::Of<T>()) != nullptr;
 }
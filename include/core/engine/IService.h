@@ -9,6 +9,9 @@ public:
 
 	virtual void Init() {}
 	virtual void Update() {}
+	// Simulation work. RunnerService runs every service's FixedUpdate once per simulation
+	// step from inside its own Update, so it happens before later services' frame Update.
+	virtual void FixedUpdate() {}
 	virtual void Shutdown() {}
 
 	void SetHost(GameServiceHost* host) { Host = host; }
@@ -12,10 +12,15 @@ public:
 
 	InputManager& GetInput() const;
 
+	void FixedUpdate() override;
+
 	void BeginFrame();
 	void ProcessEvent(const SDL_Event& event);
 	void EndFrame();
 
 private:
 	InputManager& Input;
+	// Pressed/Released edges are aged once a simulation step has seen them, not per frame,
+	// so a frame that runs no step keeps them and a frame with several steps reports them once.
+	bool StepSawEdges = false;
 };
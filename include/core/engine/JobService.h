@@ -0,0 +1,151 @@
+#pragma once
+
+#include <core/engine/IService.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobGraph;
+
+/**
+ * Work-stealing thread pool. Each worker owns a deque: it pops its own work LIFO and steals
+ * from the front of the others' when it runs dry. Threads that wait on a group run queued
+ * jobs while they wait, so nested parallel work cannot deadlock.
+ *
+ * Jobs must not make structural changes (enable/disable, spawn, pool fetch). They queue
+ * those with Defer, and the owner of the sync point applies them with FlushCommands.
+ */
+class JobService final : public IService
+{
+public:
+	using Job = std::function<void()>;
+
+	// Completion counter for a set of submitted jobs.
+	class JobGroup
+	{
+	public:
+		bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobService;
+		std::atomic<size_t> Pending{ 0 };
+	};
+
+	// 0 sizes the pool to the hardware, keeping one core for the calling thread.
+	explicit JobService(size_t workerCount = 0);
+	~JobService() override;
+
+	void Init() override;
+	void Shutdown() override;
+
+	size_t GetWorkerCount() const { return Workers.size(); }
+	// Threads that can run jobs: the pool plus the calling thread.
+	size_t GetThreadSlotCount() const { return Workers.size() + 1; }
+	// 0 outside the pool, 1..N on workers. Lets jobs index per-thread scratch without locking.
+	static size_t GetCurrentThreadSlot();
+
+	void Submit(JobGroup& group, Job job);
+	void Wait(JobGroup& group);
+
+	// Splits [0, count) into ranges of about `grain` items and calls fn(begin, end) on each.
+	// The calling thread runs the first range itself; small inputs never leave it.
+	template <typename Fn>
+	void ParallelFor(size_t count, size_t grain, Fn&& fn);
+
+	// Runs every task of the graph once its dependencies have finished; blocks until all are done.
+	void Run(JobGraph& graph);
+
+	// Per-thread command buffers: safe to call from any job, replayed in thread-slot order.
+	void Defer(Job command);
+	void FlushCommands();
+
+private:
+	struct QueuedJob
+	{
+		Job Work;
+		JobGroup* Group = nullptr;
+	};
+
+	struct WorkQueue
+	{
+		std::mutex Mutex;
+		std::deque<QueuedJob> Jobs;
+	};
+
+	void StartWorkers();
+	void StopWorkers();
+	void WorkerLoop(size_t slot);
+	bool TryTake(size_t slot, QueuedJob& out);
+	void Execute(QueuedJob& job);
+
+	size_t RequestedWorkers;
+	std::vector<std::thread> Workers;
+	// Slot 0 belongs to threads outside the pool (the main thread); workers use 1..N.
+	std::vector<std::unique_ptr<WorkQueue>> Queues;
+	std::vector<std::vector<Job>> CommandBuffers;
+
+	std::atomic<size_t> QueuedJobs{ 0 };
+	std::mutex SleepMutex;
+	std::condition_variable SleepCondition;
+	bool Stopping = false;
+};
+
+// Tasks with explicit ordering constraints, e.g. "physics after AI, animation after physics".
+class JobGraph
+{
+public:
+	using TaskId = size_t;
+
+	TaskId AddTask(JobService::Job work);
+	// `after` starts only once `before` has finished.
+	void AddDependency(TaskId before, TaskId after);
+	void Clear() { Tasks.clear(); }
+	size_t Size() const { return Tasks.size(); }
+
+private:
+	friend class JobService;
+
+	struct Task
+	{
+		JobService::Job Work;
+		std::vector<TaskId> Successors;
+		size_t DependencyCount = 0;
+	};
+
+	std::vector<Task> Tasks;
+};
+
+template <typename Fn>
+void JobService::ParallelFor(size_t count, size_t grain, Fn&& fn)
+{
+	if (count == 0) {
+		return;
+	}
+	if (grain == 0) {
+		grain = 1;
+	}
+	if (Workers.empty() || count <= grain) {
+		fn(size_t(0), count);
+		return;
+	}
+
+	// No more ranges than threads can usefully run; each range is at least `grain` items.
+	const size_t maxRanges = Workers.size() + 1;
+	const size_t ranges = std::min((count + grain - 1) / grain, maxRanges);
+	const size_t rangeSize = (count + ranges - 1) / ranges;
+
+	JobGroup group;
+	for (size_t begin = rangeSize; begin < count; begin += rangeSize) {
+		const size_t end = std::min(begin + rangeSize, count);
+		Submit(group, [&fn, begin, end]() { fn(begin, end); });
+	}
+	fn(size_t(0), std::min(rangeSize, count));
+	Wait(group);
+}
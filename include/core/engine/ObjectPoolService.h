@@ -1,13 +1,45 @@
 #pragma once
 
 #include <core/engine/IService.h>
+#include <core/Entity.h>
+#include <core/EntityHandle.h>
+#include <core/StringId.h>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 #include <string_view>
 #include <vector>
 
-class Entity;
 class PrefabSystem;
+class World;
+
+// Pools grow mostly ahead of demand, a few entities per frame, instead of all at once when
+// a fetch finds them dry.
+struct PoolGrowthSettings
+{
+	// Entities created on the spot when a fetch finds its pool dry; the rest of the growth is queued.
+	size_t EmergencyReserve = 2;
+	// Per-frame budget for queued growth, shared by all pools; whichever runs out first ends
+	// the frame's work.
+	size_t EntitiesPerFrame = 4;
+	float MicrosecondsPerFrame = 1000.0f;
+	// Free entities each pool keeps on hand, in seconds of its estimated acquisition rate.
+	float LookaheadSeconds = 0.5f;
+	// Weight of the latest frame in the moving average of acquisitions per second.
+	float RateSmoothing = 0.1f;
+};
+
+// Bytes are estimated from entity footprints (see Entity::GetMemoryFootprint) plus the
+// pool's own bookkeeping.
+struct PoolStats
+{
+	std::string PrefabId;
+	size_t Size = 0;
+	size_t ActiveCount = 0;
+	size_t PendingGrowth = 0;
+	size_t CurrentBytes = 0;
+	size_t PeakBytes = 0;
+};
 
 class ObjectPoolService final : public IService
 {
@@ -21,22 +53,87 @@ public:
 	void Update() override;
 	void Shutdown() override;
 
+	Entity* FetchPrefab(StringId prefabId);
+	// Interns the name first; for tools and scripts. Game code passes a constexpr StringId.
 	Entity* FetchPrefab(std::string_view prefabId);
+	// Builds every pool a prefab declares up to its initial size, so the instantiation cost
+	// lands at scene build rather than on the first fetch.
+	void PrewarmPools();
 	void ClearPools();
 
+	const PoolGrowthSettings& GetGrowthSettings() const { return GrowthSettings; }
+	void SetGrowthSettings(const PoolGrowthSettings& settings) { GrowthSettings = settings; }
+
+	std::vector<PoolStats> GetPoolStats() const;
+	// Totals across all pools; the peak outlives pools that have since been erased.
+	size_t GetCurrentMemory() const { return CurrentBytes; }
+	size_t GetPeakMemory() const { return PeakBytes; }
+
 private:
-	struct Pool
+	// Entities report back through Entity::Disable with their index in Entries as the ticket,
+	// so acquiring pops a free slot instead of scanning. Pools live in map nodes, whose
+	// addresses stay put, and must detach their entities before going away.
+	struct Pool final : EntityReleaseListener
 	{
+		Pool() = default;
+		Pool(const Pool&) = delete;
+		Pool& operator=(const Pool&) = delete;
+
+		StringId Id;
 		std::string PrefabId;
-		size_t Size = 0;
-		std::vector<Entity*> Entries;
+		std::vector<EntityHandle> Entries;
+		// Indices into Entries of released entities, most recent on top. Checked again when
+		// popped, since the entity may since have been destroyed or enabled by someone else.
+		std::vector<uint32_t> FreeSlots;
+		// Parallel to Entries; keeps a slot from being pushed twice.
+		std::vector<uint8_t> SlotFree;
 		float NextMaintenanceTime = 0.0f;
+		// From the prefab's "pool" block; undeclared pools start at DefaultPoolSize and double.
+		bool Declared = false;
+		size_t InitialSize = DefaultPoolSize;
+		size_t MaxSize = 0;
+		float Growth = 2.0f;
+		bool ReportedOverMax = false;
+		// Entities still to create, a few per frame.
+		size_t PendingGrowth = 0;
+		uint32_t FrameAcquisitions = 0;
+		// Moving average of fetches per second.
+		float AcquisitionRate = 0.0f;
+		// Dropped by maintenance while some entities were still out: each is destroyed on
+		// release and the pool is erased once none are left. A fetch cancels it.
+		bool Draining = false;
+		World* DrainWorld = nullptr;
+		// Largest footprint of an entity the pool has built.
+		size_t EntityFootprint = 0;
+		size_t PeakBytes = 0;
+
+		size_t Size() const { return Entries.size(); }
+		size_t GetBytes() const;
+		size_t GetActiveCount() const { return Entries.size() - FreeSlots.size(); }
+		void OnEntityReleased(Entity& entity, uint32_t ticket) override;
 	};
 
 	PrefabSystem& Prefabs;
-	std::unordered_map<std::string, Pool> Pools;
-	Pool& GetOrCreatePool(std::string_view prefabId);
+	std::unordered_map<StringId, Pool> Pools;
+	PoolGrowthSettings GrowthSettings;
+	size_t CurrentBytes = 0;
+	size_t PeakBytes = 0;
+	Pool& GetOrCreatePool(StringId prefabId);
 	Entity* AcquireFromPool(Pool& pool);
+	Entity* PopFreeEntry(Pool& pool, const World& world);
 	void EnsurePoolSize(Pool& pool, size_t newSize);
+	// Free entities the pool should have on hand for its acquisition rate.
+	size_t GetHeadroom(const Pool& pool) const;
+	// Size the pool's growth factor takes it to next, within its declared max.
+	size_t GetGrowthTarget(const Pool& pool) const;
+	// Queues growth up to `targetSize`, never past the declared max.
+	void ScheduleGrowth(Pool& pool, size_t targetSize);
+	// Tops up pools' headroom, then works through queued growth within the frame budget.
+	void UpdateGrowth();
+	// Drops entries whose entity the world has since destroyed, plus up to `freeToDrop`
+	// released ones, which the world destroys at its next sync point; re-issues every ticket.
+	void CompactPool(Pool& pool, World& world, size_t freeToDrop);
+	void DetachPool(Pool& pool, const World& world);
 	bool RunMaintenance(Pool& pool);
+	void UpdateMemoryStats();
 };
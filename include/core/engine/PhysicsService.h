@@ -1,25 +1,95 @@
 #pragma once
 
-#include <core/QuadTree.h>
+#include <core/Broadphase.h>
+#include <core/Entity.h>
 #include <core/Vec2.h>
 #include <core/engine/IService.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+// Row i holds the layers that layer i interacts with. Kept symmetric.
+using CollisionMatrix = std::array<CollisionLayerMask, MaxCollisionLayers>;
+
+// Only the tag pairs some component reacts to: no bullet-vs-bullet, no friendly fire,
+// and enemy shots pass through hazards.
+CollisionMatrix DefaultCollisionMatrix();
+
 struct PhysicsConfig
 {
 	Vec2 Gravity = Vec2(0.0f, 1000.0f);
 	float TerminalVelocity = 800.0f;
 	float GroundLevel = 460.0f;
 	Rectf WorldBounds = Rectf(0.0f, 0.0f, 800.0f, 600.0f);
+	CollisionMatrix LayerMatrix = DefaultCollisionMatrix();
+	// Pick per scene: see BenchmarkBroadphases for choosing from a recorded distribution.
+	BroadphaseConfig Broadphase;
+	// Ticks an entity's bounds and layers must stay unchanged before it sleeps; 0 never sleeps.
+	uint32_t SleepTicks = 30;
+	// Confirm AABB overlaps against both sprites' alpha masks (see PixelMask).
+	bool PixelCollision = true;
+};
+
+struct RaycastHit
+{
+	EntityHandle Entity;
+	// Along the normalized ray; 0 when the origin starts inside the entity.
+	float Distance = 0.0f;
+	Vec2 Point;
+};
+
+// Called with the entity carrying the response's own tag first.
+using CollisionHandler = std::function<void(Entity& self, Entity& other)>;
+
+// One row of the response table: `Handler` runs when a `Self`-tagged entity has `Event`
+// with an `Other`-tagged one.
+struct CollisionResponse
+{
+	ENTITY_TAG Self = player;
+	ENTITY_TAG Other = player;
+	CollisionEvent Event = CollisionEvent::Enter;
+	std::string HandlerName;
+	CollisionHandler Handler;
+	// Times the handler ran since the last ResetCollisionResponseCounts.
+	uint64_t Calls = 0;
 };
 
+using PhysicsBodyId = uint32_t;
+constexpr PhysicsBodyId InvalidPhysicsBody = static_cast<PhysicsBodyId>(-1);
+
 class PhysicsService final : public IService
 {
 public:
 	PhysicsService();
 	explicit PhysicsService(const PhysicsConfig& config);
 
-	void Update() override;
+	void FixedUpdate() override;
+
+	// Integrates every body and clamps it to the world bounds and ground in one batched pass.
+	void StepBodies(float deltaTime);
+
+	PhysicsBodyId CreateBody(Entity& owner);
+	void DestroyBody(PhysicsBodyId body);
+	// Only active bodies are integrated; bodies of disabled (pooled) entities sit past the active range.
+	void SetBodyActive(PhysicsBodyId body, bool active);
+
+	Vec2 GetBodyVelocity(PhysicsBodyId body) const;
+	void SetBodyVelocity(PhysicsBodyId body, const Vec2& velocity);
+	void SetBodyVelocityX(PhysicsBodyId body, float x) { Bodies.VelocityX[Dense(body)] = x; }
+	void SetBodyVelocityY(PhysicsBodyId body, float y) { Bodies.VelocityY[Dense(body)] = y; }
+	void AddBodyAcceleration(PhysicsBodyId body, const Vec2& acceleration);
+	void ClearBodyAcceleration(PhysicsBodyId body);
+	float GetBodyGravityScale(PhysicsBodyId body) const { return Bodies.GravityScale[Dense(body)]; }
+	void SetBodyGravityScale(PhysicsBodyId body, float scale) { Bodies.GravityScale[Dense(body)] = scale; }
+	// Bullets are collided along the path they moved since the last collision pass rather than
+	// only where they ended up, so fast movers can't tunnel through thin targets. A bullet
+	// reports only its earliest hit along that path each tick.
+	bool IsBodyBullet(PhysicsBodyId body) const { return Bodies.Bullet[Dense(body)] != 0; }
+	void SetBodyBullet(PhysicsBodyId body, bool bullet) { Bodies.Bullet[Dense(body)] = bullet ? 1 : 0; }
 
 	float GetGroundLevel() const { return GroundLevel; }
 	Vec2 GetGravity() const { return Gravity; }
@@ -30,14 +100,172 @@ public:
 	void SetTerminalVelocity(float velocity) { TerminalVelocity = velocity; }
 	void SetGroundLevel(float level) { GroundLevel = level; }
 	void SetWorldBounds(const Rectf& bounds);
+	const BroadphaseConfig& GetBroadphaseConfig() const { return BroadphaseSettings; }
+	void SetBroadphase(const BroadphaseConfig& config);
+	// This tick's collidable entities, e.g. to feed BenchmarkBroadphases.
+	const std::vector<BroadphaseProxy>& GetBroadphaseProxies() const { return FrameProxies; }
+	bool GetPixelCollision() const { return PixelCollision; }
+	void SetPixelCollision(bool enabled) { PixelCollision = enabled; }
+	uint32_t GetSleepTicks() const { return SleepTicks; }
+	void SetSleepTicks(uint32_t ticks) { SleepTicks = ticks; }
+	// Whether the entity sat out the last collision pass as static or asleep. Resting
+	// entities are only tested against moving ones; their contacts with each other carry over.
+	bool IsResting(EntityHandle handle) const;
+
+	// Updates both directions so the matrix stays symmetric.
+	void SetLayersCollide(ENTITY_TAG a, ENTITY_TAG b, bool collide);
+	// Layers that anything on `layers` interacts with.
+	CollisionLayerMask GetCollisionMask(CollisionLayerMask layers) const;
+	bool LayersCollide(CollisionLayerMask a, CollisionLayerMask b) const { return (GetCollisionMask(a) & b) != 0; }
+
+	// Collision response table, called for each side of a contact after its components'
+	// OnCollision* hooks. Handlers are registered by name, so tables can come from data; a
+	// response copies its handler, so register handlers before adding the responses using them.
+	void RegisterCollisionHandler(const std::string& name, CollisionHandler handler);
+	// False if no handler is registered under `handlerName`.
+	bool AddCollisionResponse(ENTITY_TAG self, ENTITY_TAG other, CollisionEvent event, const std::string& handlerName);
+	void ClearCollisionResponses();
+	// Sorted by (Self, Other, Event), with per-row call counts for profiling.
+	const std::vector<CollisionResponse>& GetCollisionResponses() const { return Responses; }
+	void ResetCollisionResponseCounts();
+
+	// Spatial queries over the entities of the last collision pass, answered from both the
+	// moving and resting broadphases. Only entities on one of `layers` are considered
+	// (LayerOf(tag) for a tag).
+	// Results are appended to the caller's buffer, so a reused buffer never allocates.
+	void QueryRect(const Rectf& range, CollisionLayerMask layers, std::vector<EntityHandle>& results) const;
+	void QueryCircle(const Vec2& center, float radius, CollisionLayerMask layers, std::vector<EntityHandle>& results) const;
+	// Closest hit along the ray within maxDistance; `direction` need not be normalized.
+	bool Raycast(const Vec2& origin, const Vec2& direction, float maxDistance, CollisionLayerMask layers, RaycastHit& hit) const;
+	// Every hit within maxDistance, nearest first.
+	void RaycastAll(const Vec2& origin, const Vec2& direction, float maxDistance, CollisionLayerMask layers, std::vector<RaycastHit>& hits) const;
+	// Entity whose bounds are closest to `point`, or an invalid handle if none is within maxDistance.
+	EntityHandle FindNearest(const Vec2& point, CollisionLayerMask layers, float maxDistance = 1.0e9f) const;
 
 private:
-	void UpdateEntityCollisions(const std::vector<Entity::Ptr>& entities);
+	// Smallest range of bodies worth handing to a job worker.
+	static constexpr size_t ParallelBodyGrain = 256;
+	// Smallest run of proxies whose pair search is worth a job.
+	static constexpr size_t ParallelPairGrain = 128;
+
+	// Structure-of-arrays body storage, kept dense by swap-and-pop and partitioned so
+	// [0, ActiveCount) are active. Body ids index BodyToDense.
+	struct BodyStorage
+	{
+		std::vector<float> PositionX;
+		std::vector<float> PositionY;
+		std::vector<float> VelocityX;
+		std::vector<float> VelocityY;
+		std::vector<float> AccelerationX;
+		std::vector<float> AccelerationY;
+		std::vector<float> GravityScale;
+		std::vector<float> Width;
+		// Distance integrated since the last collision pass, which consumes it.
+		std::vector<float> MotionX;
+		std::vector<float> MotionY;
+		std::vector<uint8_t> Bullet;
+		std::vector<Entity*> Owners;
+		std::vector<PhysicsBodyId> DenseToBody;
+		std::vector<uint32_t> BodyToDense;
+		std::vector<PhysicsBodyId> FreeIds;
+		size_t ActiveCount = 0;
+
+		size_t Size() const { return Owners.size(); }
+
+		template <typename Fn>
+		void ForEachColumn(Fn&& fn)
+		{
+			fn(PositionX); fn(PositionY);
+			fn(VelocityX); fn(VelocityY);
+			fn(AccelerationX); fn(AccelerationY);
+			fn(GravityScale); fn(Width);
+			fn(MotionX); fn(MotionY); fn(Bullet);
+			fn(Owners); fn(DenseToBody);
+		}
+
+		void Swap(uint32_t a, uint32_t b);
+	};
+
+	uint32_t Dense(PhysicsBodyId body) const { return Bodies.BodyToDense[body]; }
+	void UpdateEntityCollisions(const World& world, const EntityRange& entities);
+	// This pass's proxy for the entity, or nullptr if it was not part of it.
+	const BroadphaseProxy* FindProxy(EntityHandle handle) const;
+	// Decides whether the proxy rests this tick and updates its idle count. `wasResting`
+	// reports whether it already rested last tick, i.e. is in RestingBroadphase.
+	bool UpdateRestState(const Entity& entity, const BroadphaseProxy& proxy, bool& wasResting);
+	// Moving proxies [begin, end) against the resting broadphase.
+	void FindRestingPairsInRange(size_t begin, size_t end, std::vector<BroadphasePair>& pairs) const;
+	// Takes each active body's motion for this pass and swaps the discrete pairs of bullets
+	// in CandidatePairs for their earliest swept hit.
+	void UpdateBulletPairs();
+	// Drops pairs whose sprites only overlap on transparent pixels.
+	void RemovePixelMisses(const World& world);
+	// Both broadphases: the moving one and the resting one.
+	void QueryBroadphases(const Rectf& range, CollisionLayerMask layers, std::vector<EntityHandle>& found) const;
+
+	void UpdateContacts(const World& world);
+	// Returns whether the pair is still in contact afterwards.
+	bool DispatchContact(const World& world, const BroadphasePair& pair, CollisionEvent event);
+	// Runs the table's handlers for `self` meeting `other`.
+	void RunCollisionResponses(Entity& self, Entity& other, CollisionEvent event);
 
 	Vec2 Gravity;
 	float TerminalVelocity;
 	float GroundLevel;
 	Rectf WorldBounds;
-	QuadTree CollisionTree;
-	std::vector<Entity*> CollisionCandidates;
+	CollisionMatrix LayerMatrix;
+	BroadphaseConfig BroadphaseSettings;
+	uint32_t SleepTicks;
+	bool PixelCollision;
+	// Moving entities, rebuilt every tick.
+	std::unique_ptr<IBroadphase> Broadphase;
+	// Static and sleeping entities, rebuilt only when that set or one of its members changes.
+	std::unique_ptr<IBroadphase> RestingBroadphase;
+	std::vector<BroadphaseProxy> FrameProxies;
+	std::vector<BroadphaseProxy> MovingProxies;
+	std::vector<BroadphaseProxy> RestingProxies;
+	// Entities RestingBroadphase was last built from. A resting entity's bounds can't have
+	// changed, so the set only changes when an entity joins or this many fail to rest again.
+	size_t BuiltRestingCount = 0;
+	bool RestingBroadphaseStale = true;
+
+	// Per handle index; a generation or tick mismatch means the entity is new to collision.
+	struct RestState
+	{
+		uint32_t Generation = 0;
+		uint32_t LastTick = 0;
+		uint32_t IdleTicks = 0;
+		Rectf Bounds;
+		CollisionLayerMask Layers = 0;
+		// Animation frame and flip: a new frame changes the pixel mask, so the body counts
+		// as moved and its contacts are tested again.
+		Recti Frame;
+		bool FlipX = false;
+		bool Resting = false;
+	};
+	std::vector<RestState> RestStates;
+	// Starts at 1 so a zeroed RestState never reads as seen on the previous tick.
+	uint32_t CollisionTick = 1;
+	// Parallel to FrameProxies: how far each moved since the last pass (zero for entities
+	// without a body) and whether it is swept as a bullet.
+	std::vector<Vec2> ProxyMotion;
+	std::vector<uint8_t> ProxyIsBullet;
+	std::vector<uint32_t> BulletProxies;
+	// Handle index -> position in FrameProxies; stale entries are caught by the handle check.
+	std::vector<uint32_t> ProxyLookup;
+	// Union of FrameProxies' bounds; bounds how far FindNearest ever has to search.
+	Rectf ProxyExtent;
+	std::vector<BroadphasePair> CandidatePairs;
+	// One per job thread slot, merged into CandidatePairs.
+	std::vector<std::vector<BroadphasePair>> PairBuffers;
+	// Pairs that were touching as of the last tick, sorted like CandidatePairs. A pair is
+	// identified by both handles, so a reused slot reads as a new contact.
+	std::vector<BroadphasePair> Contacts;
+	std::vector<BroadphasePair> PreviousContacts;
+	std::unordered_map<std::string, CollisionHandler> CollisionHandlers;
+	std::vector<CollisionResponse> Responses;
+	// Per event and self tag, the other tags with at least one response, so pairs nothing
+	// responds to skip the table lookup.
+	std::array<std::array<CollisionLayerMask, MaxCollisionLayers>, 3> RespondsTo{};
+	BodyStorage Bodies;
 };
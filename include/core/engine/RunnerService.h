@@ -3,21 +3,52 @@
 #include <core/engine/IService.h>
 #include <SDL3/SDL.h>
 
+/**
+ * Owns the clocks and drives simulation steps. Each frame it measures the real frame time and
+ * runs GameServiceHost::FixedUpdate for every step that frame holds.
+ *
+ * With no fixed tick rate (the default) a frame is exactly one step of the frame's length.
+ * With one, frame time goes into an accumulator that is drained in fixed steps, and the
+ * remainder becomes the interpolation alpha that rendering blends positions with.
+ */
 class RunnerService final : public IService
 {
 public:
+	// Longest frame fed to the accumulator, so a hitch cannot queue up seconds of steps.
+	static constexpr float MaxFrameTime = 0.25f;
+	// Steps per frame before the backlog is dropped; past this the game runs in slow motion
+	// instead of spending ever longer frames catching up.
+	static constexpr int MaxStepsPerFrame = 8;
+
 	void Init() override;
 	void Update() override;
 
+	// Length of the current simulation step.
 	float GetDeltaTime() const { return DeltaTimeValue; }
+	// Simulation time, advanced by every step.
 	float GetElapsedTime() const { return ElapsedTime; }
+	// Real time since the previous frame.
+	float GetFrameDeltaTime() const { return FrameDeltaTime; }
+	// Where this frame sits between the last two simulation states, in [0, 1].
+	float GetInterpolationAlpha() const { return InterpolationAlpha; }
+
+	// e.g. 60 or 120; 0 goes back to one variable-length step per frame.
+	void SetFixedTickRate(float ticksPerSecond);
+	float GetFixedTickRate() const { return FixedDeltaTime > 0.0f ? 1.0f / FixedDeltaTime : 0.0f; }
+	bool IsFixedTimestep() const { return FixedDeltaTime > 0.0f; }
 
 	void ResetClock();
 
 private:
+	void RunStep(float deltaTime);
+
 	Uint64 LastTime = 0;
 	Uint64 Frequency = 0;
 	float DeltaTimeValue = 0.0f;
 	float ElapsedTime = 0.0f;
+	float FrameDeltaTime = 0.0f;
+	float FixedDeltaTime = 0.0f;
+	float Accumulator = 0.0f;
+	float InterpolationAlpha = 1.0f;
 	bool Started = false;
 };
@@ -3,6 +3,7 @@
 namespace ServiceOrder
 {
 	constexpr int Runner = 0;
+	constexpr int Jobs = 5;
 	constexpr int Timer = 10;
 	constexpr int Input = 20;
 	constexpr int Physics = 30;
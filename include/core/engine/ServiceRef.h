@@ -0,0 +1,35 @@
+#pragma once
+
+#include <core/engine/GameServiceHost.h>
+
+/**
+ * Caches a service pointer so steady-state access is a single dereference.
+ * Services are heap allocated and never move, so the cached pointer survives a late
+ * AddService re-sorting the host. A ref created before its service is registered
+ * resolves on first use instead.
+ */
+template <typename T>
+class ServiceRef
+{
+public:
+	explicit ServiceRef(const GameServiceHost& host)
+		: Host(&host),
+		Cached(host.TryGet<T>())
+	{
+	}
+
+	T& Get() const
+	{
+		if (!Cached) {
+			Cached = &Host->Get<T>();
+		}
+		return *Cached;
+	}
+
+	T* operator->() const { return &Get(); }
+	T& operator*() const { return Get(); }
+
+private:
+	const GameServiceHost* Host;
+	mutable T* Cached;
+};
@@ -9,7 +9,7 @@
 class TimerService final : public IService
 {
 public:
-	void Update() override;
+	void FixedUpdate() override;
 
 	TimerHandle ScheduleTimer(float delay, std::function<void()> callback);
 	void CancelTimer(TimerHandle handle);
@@ -10,7 +10,10 @@ class WorldService final : public IService
 {
 public:
 	void Init() override;
+	// Simulation runs per step; Update only renders.
+	void FixedUpdate() override;
 	void Update() override;
+	void Shutdown() override;
 
 	void SetGameMode(GameMode* mode);
 	GameMode* GetGameMode() const { return Mode; }
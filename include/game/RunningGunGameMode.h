@@ -2,6 +2,7 @@
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <core/GameMode.h>
+#include <core/EntityHandle.h>
 #include <core/engine/GameServiceHost.h>
 #include <core/events/MulticastDelegate.h>
 #include <core/UIHealthBar.h>
@@ -27,10 +28,8 @@ private:
 	UIText*						StatusTextUI;
 	TTF_Font*					GameFont;
 
-	Entity*						PlayerEntity;
-	Entity*						BullEntity;
-	PlayerComponent*			PlayerComponentRef;
-	BullComponent*				BullComponentRef;
+	EntityHandle				PlayerEntity;
+	EntityHandle				BullEntity;
 
 	float						SpawnScorpion1Interval;
 	float						LastSpawn1Time;
@@ -47,6 +46,8 @@ private:
 	void						SetStatusText(const std::string& _text);
 	void						SubscribeToEvents();
 	void						UnsubscribeFromEvents();
+	PlayerComponent*			GetPlayerComponent() const;
+	BullComponent*				GetBullComponent() const;
 
 public:
 								RunningGunGameMode(SDL_Renderer* _renderer, GameServiceHost& _services, PrefabSystem& _prefabs, World& _world);
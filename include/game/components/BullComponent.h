@@ -1,19 +1,24 @@
 #pragma once
-#include <map>
+#include <string_view>
+#include <unordered_map>
 #include <core/Component.h>
+#include <core/StringId.h>
 #include <core/animation/AnimationStateMachine.h>
 #include <core/Vec2.h>
 #include <core/events/MulticastDelegate.h>
+#include <core/engine/ServiceRef.h>
 
 #include <BullStates.h>
 
+class ObjectPoolService;
+
 typedef std::unique_ptr<BullState> BullStatePtr;
 
 class BullComponent :
 	public Component
 {
 private:
-	std::map<std::string, BullStatePtr> States;
+	std::unordered_map<StringId, BullStatePtr> States;
 	AnimationStateMachine*				Animator;
 	BullState*						CurrentState;
 
@@ -23,21 +28,22 @@ private:
 	Vec2							Offset2;
 
 	Vec2							ProjectileOffset;
+	ServiceRef<ObjectPoolService>	Pools;
 public:
 									BullComponent(Entity& _entity, GameServiceHost& _context);
 									~BullComponent();
 
 	void							Start();
 	void							Update();
-	void							PostUpdate();
 
 	void							Shoot();
 	void							SwitchShootPositions();
 
-	void							AddState(const std::string& _id, BullStatePtr _state);
-	void							SwitchState(const std::string& _id);
+	void							AddState(StringId _id, BullStatePtr _state);
+	void							AddState(std::string_view _id, BullStatePtr _state);
+	void							SwitchState(StringId _id);
+	void							SwitchState(std::string_view _id);
 	void							Damage();
-	void							OnCollide(Entity& _other);
 
 	// Events - GameMode subscribes to these
 	MulticastDelegate<Entity*>		OnDied;
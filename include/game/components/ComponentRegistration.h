@@ -2,5 +2,8 @@
 
 class PlayerInputConfig;
 class ComponentRegistry;
+class PhysicsService;
 
 void RegisterDefaultComponents(ComponentRegistry& registry, const PlayerInputConfig& inputConfig);
+// Named handlers for the components' collision reactions, plus the default table using them.
+void RegisterDefaultCollisionResponses(PhysicsService& physics);
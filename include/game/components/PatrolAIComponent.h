@@ -1,8 +1,10 @@
 #pragma once
 #include <core/Component.h>
+#include <core/engine/ServiceRef.h>
 
 class AnimationStateMachine;
 class PhysicsComponent;
+class RunnerService;
 
 class PatrolAIComponent :
 	public Component
@@ -16,7 +18,11 @@ private:
 	float MoveSpeed;
 	AnimationStateMachine* Animator;
 	PhysicsComponent* PhysicsHandle;
+	ServiceRef<RunnerService> Runner;
 public:
+	//Update/PostUpdate only steer this entity, so batches may run on job workers
+	static constexpr bool ParallelUpdate = true;
+
 	PatrolAIComponent(Entity& _entity, GameServiceHost& _context, float _speed);
 	~PatrolAIComponent();
 
@@ -25,7 +31,6 @@ public:
 	void PostUpdate();
 
 	void ChangeDirection();
-	void OnCollide(Entity& _other);
 
 	void Damage();
 	void Die();
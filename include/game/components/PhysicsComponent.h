@@ -1,28 +1,27 @@
 #pragma once
 #include <core/Component.h>
 #include <core/Vec2.h>
+#include <core/engine/PhysicsService.h>
 
 class GameServiceHost;
-class PhysicsService;
 
+// Thin handle onto a body owned by PhysicsService, which integrates all bodies in one batched pass.
 class PhysicsComponent :
 	public Component
 {
 private:
 	PhysicsService& PhysContext;
-	Vec2 Velocity;
-	Vec2 AccumulatedAcceleration;
-	float GravityScale;
+	PhysicsBodyId Body;
 public:
 	PhysicsComponent(Entity& _entity, GameServiceHost& _context);
 	~PhysicsComponent();
 
-	void Update();
-	void PostUpdate();
+	void Start();
+	void OnDisable();
 
 	Vec2 GetVelocity() const;
-	float GetVelocityX() const { return Velocity.x; }
-	float GetVelocityY() const { return Velocity.y; }
+	float GetVelocityX() const { return PhysContext.GetBodyVelocity(Body).x; }
+	float GetVelocityY() const { return PhysContext.GetBodyVelocity(Body).y; }
 	void SetVelocity(const Vec2& _velocity);
 	void SetVelocity(float _x, float _y);
 	void SetVelocityX(float _x);
@@ -31,8 +30,9 @@ public:
 	void AddAcceleration(const Vec2& _acceleration);
 	void ClearAcceleration();
 	void SetGravityScale(float _scale);
-	float GetGravityScale() const { return GravityScale; }
+	float GetGravityScale() const { return PhysContext.GetBodyGravityScale(Body); }
+	//swept collision for fast movers, see PhysicsService::SetBodyBullet
+	void SetBullet(bool _bullet) { PhysContext.SetBodyBullet(Body, _bullet); }
+	bool IsBullet() const { return PhysContext.IsBodyBullet(Body); }
 	bool IsGrounded() const;
-
-	void OnCollide(Entity& _other);
 };
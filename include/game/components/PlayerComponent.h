@@ -3,6 +3,7 @@
 #include <core/Component.h>
 #include <core/Vec2.h>
 #include <core/events/MulticastDelegate.h>
+#include <core/engine/ServiceRef.h>
 #include <game/input/PlayerInputConfig.h>
 
 constexpr auto BulletCoolDown = .3f;
@@ -12,6 +13,9 @@ constexpr auto JumpSpeed = 500.0f;
 
 class PlayerAction;
 class PhysicsComponent;
+class RunnerService;
+class InputService;
+class ObjectPoolService;
 class PlayerComponent :
 	public Component
 {
@@ -39,6 +43,10 @@ private:
 	std::unique_ptr<PlayerAction>	ShootActionHandle;
 	const PlayerInputConfig&		InputConfig;
 
+	ServiceRef<RunnerService>		Runner;
+	ServiceRef<InputService>		Input;
+	ServiceRef<ObjectPoolService>	Pools;
+
 public:
 									PlayerComponent(Entity& _entity, GameServiceHost& _context, const PlayerInputConfig& _inputConfig);
 									~PlayerComponent();
@@ -71,8 +79,6 @@ public:
 	void							OnDeath();
 	void							OnVictory();
 
-	void							OnCollide(Entity& _other);
-
 	// Events - GameMode subscribes to these
 	MulticastDelegate<Entity*>		OnDied;
 };
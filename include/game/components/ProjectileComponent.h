@@ -1,7 +1,12 @@
 #pragma once
 #include <core/Component.h>
+#include <core/EntityHandle.h>
+#include <core/engine/ServiceRef.h>
 
 class PhysicsComponent;
+class JobService;
+class RunnerService;
+class WorldService;
 
 class ProjectileComponent
 	:public Component
@@ -11,18 +16,24 @@ private:
 	float		SpawnTime = 0;
 	float		LifeSpan = 3.0;
 
-	Entity*	Shooter = nullptr;
+	EntityHandle	Shooter;
 	PhysicsComponent* PhysicsHandle = nullptr;
+	ServiceRef<RunnerService> Runner;
+	ServiceRef<JobService> Jobs;
+	ServiceRef<WorldService> Worlds;
 public:
+	//Update only moves this entity; expiry is deferred, so batches may run on job workers
+	static constexpr bool ParallelUpdate = true;
+
 	ProjectileComponent(Entity& _entity, GameServiceHost& _context, float _speed, float _lifeSpan = 3.0f);
 	~ProjectileComponent();
 
 	void Start();
 	void Update();
-	void PostUpdate();
 
-	void Activate(Entity* _shooter);
-	void SetShooter(Entity* _shooter);
+	void Activate(const Entity& _shooter);
+	void SetShooter(const Entity& _shooter);
 
-	void OnCollide(Entity& _other);
+	//the collision response table only routes hits on things a projectile should stop at
+	void OnHit(Entity& _other);
 };
@@ -21,7 +21,8 @@ void BullState::ExitState(){}
 //Default State
 BullDefaultState::BullDefaultState(BullComponent& _bull)
 	:BullState(_bull),
-	LastShot(0)
+	LastShot(0),
+	Runner(_bull.GetContext())
 {
 }
 BullDefaultState::~BullDefaultState()
@@ -34,7 +35,7 @@ void BullDefaultState::EnterState()
 
 void BullDefaultState::Update() 
 {
-	float _currentTime = BullRef.GetContext().Get<RunnerService>().GetElapsedTime();
+	float _currentTime = Runner->GetElapsedTime();
 	if (_currentTime - LastShot > ShootFrequency) {
 		BullRef.Shoot();
 		LastShot = _currentTime;
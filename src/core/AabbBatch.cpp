@@ -0,0 +1,295 @@
+#include <core/AabbBatch.h>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AABB_BATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC accepts every intrinsic without per-function target flags.
+#define AABB_BATCH_TARGET(_isa)
+#else
+#define AABB_BATCH_TARGET(_isa) __attribute__((target(_isa)))
+#endif
+#endif
+
+namespace {
+	struct QueryBox
+	{
+		float MinX;
+		float MinY;
+		float MaxX;
+		float MaxY;
+		CollisionLayerMask Mask;
+	};
+
+	// Candidate arrays already offset to the start of the run.
+	struct BoxRun
+	{
+		const float* MinX;
+		const float* MinY;
+		const float* MaxX;
+		const float* MaxY;
+		const CollisionLayerMask* Layers;
+		size_t Count;
+	};
+
+	using OverlapKernel = size_t(*)(const QueryBox&, const BoxRun&, uint32_t*);
+
+	// Finishes [_begin, Count) one box at a time; also the whole kernel without SIMD.
+	size_t OverlapTail(const QueryBox& _query, const BoxRun& _run, size_t _begin, uint32_t* _hits, size_t _found)
+	{
+		for (size_t _index = _begin; _index < _run.Count; ++_index) {
+			const bool _hit = ((_run.Layers[_index] & _query.Mask) != 0)
+				& (_run.MinX[_index] < _query.MaxX) & (_run.MaxX[_index] > _query.MinX)
+				& (_run.MinY[_index] < _query.MaxY) & (_run.MaxY[_index] > _query.MinY);
+			// Branchless: always write, only advance on a hit.
+			_hits[_found] = static_cast<uint32_t>(_index);
+			_found += _hit ? 1 : 0;
+		}
+		return _found;
+	}
+
+	size_t OverlapScalar(const QueryBox& _query, const BoxRun& _run, uint32_t* _hits)
+	{
+		return OverlapTail(_query, _run, 0, _hits, 0);
+	}
+
+#ifdef AABB_BATCH_X86
+	inline int LowestBit(uint32_t _bits)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long _index;
+		_BitScanForward(&_index, _bits);
+		return static_cast<int>(_index);
+#else
+		return __builtin_ctz(_bits);
+#endif
+	}
+
+	inline size_t EmitHits(uint32_t _bits, size_t _base, uint32_t* _hits, size_t _found)
+	{
+		while (_bits != 0) {
+			_hits[_found++] = static_cast<uint32_t>(_base + LowestBit(_bits));
+			_bits &= _bits - 1;
+		}
+		return _found;
+	}
+
+	AABB_BATCH_TARGET("sse2")
+	size_t OverlapSSE2(const QueryBox& _query, const BoxRun& _run, uint32_t* _hits)
+	{
+		const __m128 _queryMinX = _mm_set1_ps(_query.MinX);
+		const __m128 _queryMinY = _mm_set1_ps(_query.MinY);
+		const __m128 _queryMaxX = _mm_set1_ps(_query.MaxX);
+		const __m128 _queryMaxY = _mm_set1_ps(_query.MaxY);
+		const __m128i _mask = _mm_set1_epi32(static_cast<int>(_query.Mask));
+		const __m128i _zero = _mm_setzero_si128();
+
+		size_t _index = 0;
+		size_t _found = 0;
+		for (; _index + 4 <= _run.Count; _index += 4) {
+			__m128 _hit = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(_run.MinX + _index), _queryMaxX),
+				_mm_cmpgt_ps(_mm_loadu_ps(_run.MaxX + _index), _queryMinX));
+			_hit = _mm_and_ps(_hit, _mm_cmplt_ps(_mm_loadu_ps(_run.MinY + _index), _queryMaxY));
+			_hit = _mm_and_ps(_hit, _mm_cmpgt_ps(_mm_loadu_ps(_run.MaxY + _index), _queryMinY));
+			const __m128i _layers = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_run.Layers + _index)), _mask);
+			const __m128 _noLayer = _mm_castsi128_ps(_mm_cmpeq_epi32(_layers, _zero));
+			const uint32_t _bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_andnot_ps(_noLayer, _hit)));
+			_found = EmitHits(_bits, _index, _hits, _found);
+		}
+		return OverlapTail(_query, _run, _index, _hits, _found);
+	}
+
+	AABB_BATCH_TARGET("avx2")
+	size_t OverlapAVX2(const QueryBox& _query, const BoxRun& _run, uint32_t* _hits)
+	{
+		const __m256 _queryMinX = _mm256_set1_ps(_query.MinX);
+		const __m256 _queryMinY = _mm256_set1_ps(_query.MinY);
+		const __m256 _queryMaxX = _mm256_set1_ps(_query.MaxX);
+		const __m256 _queryMaxY = _mm256_set1_ps(_query.MaxY);
+		const __m256i _mask = _mm256_set1_epi32(static_cast<int>(_query.Mask));
+		const __m256i _zero = _mm256_setzero_si256();
+
+		size_t _index = 0;
+		size_t _found = 0;
+		for (; _index + 8 <= _run.Count; _index += 8) {
+			__m256 _hit = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(_run.MinX + _index), _queryMaxX, _CMP_LT_OQ),
+				_mm256_cmp_ps(_mm256_loadu_ps(_run.MaxX + _index), _queryMinX, _CMP_GT_OQ));
+			_hit = _mm256_and_ps(_hit, _mm256_cmp_ps(_mm256_loadu_ps(_run.MinY + _index), _queryMaxY, _CMP_LT_OQ));
+			_hit = _mm256_and_ps(_hit, _mm256_cmp_ps(_mm256_loadu_ps(_run.MaxY + _index), _queryMinY, _CMP_GT_OQ));
+			const __m256i _layers = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(_run.Layers + _index)), _mask);
+			const __m256 _noLayer = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_layers, _zero));
+			const uint32_t _bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_andnot_ps(_noLayer, _hit)));
+			_found = EmitHits(_bits, _index, _hits, _found);
+		}
+		// The tail is legacy-SSE code; without this GCC tail-calls into it with dirty upper
+		// halves and every SSE instruction there pays the transition penalty.
+		_mm256_zeroupper();
+		return OverlapTail(_query, _run, _index, _hits, _found);
+	}
+
+	AABB_BATCH_TARGET("avx512f")
+	size_t OverlapAVX512(const QueryBox& _query, const BoxRun& _run, uint32_t* _hits)
+	{
+		const __m512 _queryMinX = _mm512_set1_ps(_query.MinX);
+		const __m512 _queryMinY = _mm512_set1_ps(_query.MinY);
+		const __m512 _queryMaxX = _mm512_set1_ps(_query.MaxX);
+		const __m512 _queryMaxY = _mm512_set1_ps(_query.MaxY);
+		const __m512i _mask = _mm512_set1_epi32(static_cast<int>(_query.Mask));
+		const __m512i _lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+		size_t _found = 0;
+		for (size_t _index = 0; _index < _run.Count; _index += 16) {
+			// The last block uses masked loads instead of a scalar tail.
+			const size_t _left = _run.Count - _index;
+			const __mmask16 _valid = _left >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1u << _left) - 1);
+
+			__mmask16 _hit = _mm512_mask_cmp_ps_mask(_valid, _mm512_maskz_loadu_ps(_valid, _run.MinX + _index), _queryMaxX, _CMP_LT_OQ);
+			_hit = _mm512_mask_cmp_ps_mask(_hit, _mm512_maskz_loadu_ps(_valid, _run.MaxX + _index), _queryMinX, _CMP_GT_OQ);
+			_hit = _mm512_mask_cmp_ps_mask(_hit, _mm512_maskz_loadu_ps(_valid, _run.MinY + _index), _queryMaxY, _CMP_LT_OQ);
+			_hit = _mm512_mask_cmp_ps_mask(_hit, _mm512_maskz_loadu_ps(_valid, _run.MaxY + _index), _queryMinY, _CMP_GT_OQ);
+			_hit = _mm512_mask_test_epi32_mask(_hit, _mm512_maskz_loadu_epi32(_valid, _run.Layers + _index), _mask);
+
+			const __m512i _offsets = _mm512_add_epi32(_lanes, _mm512_set1_epi32(static_cast<int>(_index)));
+			_mm512_mask_compressstoreu_epi32(_hits + _found, _hit, _offsets);
+			uint32_t _bits = _hit;
+			while (_bits != 0) {
+				++_found;
+				_bits &= _bits - 1;
+			}
+		}
+		return _found;
+	}
+
+	bool CpuSupports(AabbBatch::SimdLevel _level)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		int _info[4];
+		__cpuid(_info, 1);
+		const bool _sse2 = (_info[3] & (1 << 26)) != 0;
+		const bool _osSaves = (_info[2] & (1 << 27)) != 0 && (_info[2] & (1 << 28)) != 0;
+		const unsigned long long _xcr0 = _osSaves ? _xgetbv(0) : 0;
+		__cpuidex(_info, 7, 0);
+		switch (_level) {
+		case AabbBatch::SimdLevel::SSE2:
+			return _sse2;
+		case AabbBatch::SimdLevel::AVX2:
+			return (_xcr0 & 0x6) == 0x6 && (_info[1] & (1 << 5)) != 0;
+		case AabbBatch::SimdLevel::AVX512:
+			return (_xcr0 & 0xE6) == 0xE6 && (_info[1] & (1 << 16)) != 0;
+		default:
+			return true;
+		}
+#else
+		__builtin_cpu_init();
+		switch (_level) {
+		case AabbBatch::SimdLevel::SSE2:
+			return __builtin_cpu_supports("sse2");
+		case AabbBatch::SimdLevel::AVX2:
+			return __builtin_cpu_supports("avx2");
+		case AabbBatch::SimdLevel::AVX512:
+			return __builtin_cpu_supports("avx512f");
+		default:
+			return true;
+		}
+#endif
+	}
+#endif
+
+	AabbBatch::SimdLevel DetectLevel()
+	{
+#ifdef AABB_BATCH_X86
+		for (const auto _level : { AabbBatch::SimdLevel::AVX512, AabbBatch::SimdLevel::AVX2, AabbBatch::SimdLevel::SSE2 }) {
+			if (CpuSupports(_level)) {
+				return _level;
+			}
+		}
+#endif
+		return AabbBatch::SimdLevel::Scalar;
+	}
+
+	OverlapKernel KernelFor(AabbBatch::SimdLevel _level)
+	{
+		switch (_level) {
+#ifdef AABB_BATCH_X86
+		case AabbBatch::SimdLevel::AVX512:
+			return OverlapAVX512;
+		case AabbBatch::SimdLevel::AVX2:
+			return OverlapAVX2;
+		case AabbBatch::SimdLevel::SSE2:
+			return OverlapSSE2;
+#endif
+		default:
+			return OverlapScalar;
+		}
+	}
+
+	struct Dispatch
+	{
+		AabbBatch::SimdLevel Supported;
+		std::atomic<AabbBatch::SimdLevel> Active;
+		std::atomic<OverlapKernel> Kernel;
+
+		Dispatch()
+			: Supported(DetectLevel()),
+			Active(Supported),
+			Kernel(KernelFor(Supported))
+		{
+		}
+	};
+
+	Dispatch& GetDispatch()
+	{
+		static Dispatch _dispatch;
+		return _dispatch;
+	}
+}
+
+namespace AabbBatch {
+	SimdLevel GetSupportedLevel()
+	{
+		return GetDispatch().Supported;
+	}
+
+	SimdLevel GetActiveLevel()
+	{
+		return GetDispatch().Active.load(std::memory_order_relaxed);
+	}
+
+	void SetActiveLevel(SimdLevel _level)
+	{
+		Dispatch& _dispatch = GetDispatch();
+		if (_level > _dispatch.Supported) {
+			_level = _dispatch.Supported;
+		}
+		_dispatch.Active.store(_level, std::memory_order_relaxed);
+		_dispatch.Kernel.store(KernelFor(_level), std::memory_order_relaxed);
+	}
+
+	const char* GetLevelName(SimdLevel _level)
+	{
+		switch (_level) {
+		case SimdLevel::SSE2:
+			return "SSE2";
+		case SimdLevel::AVX2:
+			return "AVX2";
+		case SimdLevel::AVX512:
+			return "AVX-512";
+		default:
+			return "Scalar";
+		}
+	}
+
+	size_t Overlap(const Rectf& _query, CollisionLayerMask _layerMask, const AabbSoA& _boxes,
+		size_t _first, size_t _count, uint32_t* _hits)
+	{
+		if (_count == 0) {
+			return 0;
+		}
+		const QueryBox _box{ _query.Left(), _query.Top(), _query.Right(), _query.Bottom(), _layerMask };
+		const BoxRun _run{ _boxes.MinX.data() + _first, _boxes.MinY.data() + _first,
+			_boxes.MaxX.data() + _first, _boxes.MaxY.data() + _first, _boxes.Layers.data() + _first, _count };
+		return GetDispatch().Kernel.load(std::memory_order_relaxed)(_box, _run, _hits);
+	}
+}
@@ -0,0 +1,95 @@
+#include <core/Broadphase.h>
+#include <core/DynamicTreeBroadphase.h>
+#include <core/QuadTreeBroadphase.h>
+#include <core/SpatialHashBroadphase.h>
+#include <core/SweepAndPruneBroadphase.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace {
+	// Per thread, since the pair search runs in parallel chunks; keeps its capacity between ticks.
+	thread_local std::vector<EntityHandle> PairCandidates;
+}
+
+void IBroadphase::FindPairsByQuery(const std::vector<BroadphaseProxy>& _proxies, size_t _begin, size_t _end,
+	std::vector<BroadphasePair>& _pairs) const
+{
+	std::vector<EntityHandle>& _candidates = PairCandidates;
+	for (size_t _index = _begin; _index < _end; ++_index) {
+		const BroadphaseProxy& _proxy = _proxies[_index];
+		if (_proxy.CollidesWith == 0) {
+			continue;
+		}
+		_candidates.clear();
+		Query(_proxy.Bounds, _proxy.CollidesWith, _candidates);
+		for (const auto _candidate : _candidates) {
+			// The collision matrix is symmetric, so each pair is kept from its lower handle only.
+			if (_candidate.Index > _proxy.Handle.Index) {
+				_pairs.push_back({ _proxy.Handle, _candidate });
+			}
+		}
+	}
+}
+
+std::unique_ptr<IBroadphase> CreateBroadphase(const BroadphaseConfig& _config, const Rectf& _worldBounds)
+{
+	switch (_config.Type) {
+	case BroadphaseType::DynamicTree:
+		return std::make_unique<DynamicTreeBroadphase>(_config.FatBoundsMargin);
+	case BroadphaseType::SweepAndPrune:
+		return std::make_unique<SweepAndPruneBroadphase>();
+	case BroadphaseType::SpatialHash:
+		return std::make_unique<SpatialHashBroadphase>(_config.CellSize);
+	case BroadphaseType::QuadTree:
+	default:
+		return std::make_unique<QuadTreeBroadphase>(_worldBounds, _config.QuadTreeCapacity, _config.QuadTreeMaxDepth);
+	}
+}
+
+std::vector<BroadphaseTiming> BenchmarkBroadphases(const std::vector<BroadphaseProxy>& _recorded,
+	const BroadphaseConfig& _baseConfig, const Rectf& _worldBounds, int _frames, float _jitter)
+{
+	const BroadphaseType _types[] = {
+		BroadphaseType::QuadTree,
+		BroadphaseType::DynamicTree,
+		BroadphaseType::SweepAndPrune,
+		BroadphaseType::SpatialHash,
+	};
+
+	std::vector<BroadphaseTiming> _results;
+	std::vector<BroadphaseProxy> _proxies;
+	std::vector<BroadphasePair> _pairs;
+	for (const auto _type : _types) {
+		BroadphaseConfig _config = _baseConfig;
+		_config.Type = _type;
+		auto _broadphase = CreateBroadphase(_config, _worldBounds);
+
+		// Same seed per backend, so every one replays identical motion.
+		std::mt19937 _random(1234);
+		std::uniform_real_distribution<float> _step(-_jitter, _jitter);
+		_proxies = _recorded;
+		size_t _pairCount = 0;
+
+		const auto _start = std::chrono::steady_clock::now();
+		for (int _frame = 0; _frame < _frames; ++_frame) {
+			for (auto& _proxy : _proxies) {
+				_proxy.Bounds.x += _step(_random);
+				_proxy.Bounds.y += _step(_random);
+			}
+			_broadphase->Update(_proxies);
+			_pairs.clear();
+			_broadphase->FindPairs(_pairs);
+			_pairCount += _pairs.size();
+		}
+		const auto _elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start);
+
+		const int _frameCount = std::max(_frames, 1);
+		_results.push_back({ _type, _elapsed.count() / _frameCount, _pairCount / static_cast<size_t>(_frameCount) });
+	}
+
+	std::sort(_results.begin(), _results.end(), [](const BroadphaseTiming& _a, const BroadphaseTiming& _b) {
+		return _a.MillisecondsPerFrame < _b.MillisecondsPerFrame;
+	});
+	return _results;
+}
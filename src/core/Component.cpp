@@ -30,7 +30,22 @@ void Component::PostUpdate()
 
 }
 
-void Component::OnCollide(Entity& _other)
+void Component::OnCollisionEnter(Entity& _other)
+{
+
+}
+
+void Component::OnCollisionStay(Entity& _other)
+{
+
+}
+
+void Component::OnCollisionExit(Entity& _other)
+{
+
+}
+
+void Component::OnDisable()
 {
 
 }
@@ -1,11 +1,11 @@
 #include <core/ComponentRegistry.h>
 
-void ComponentRegistry::Register(std::string_view type, Factory factory)
+void ComponentRegistry::Register(std::string_view type, ComponentTypeId typeId, Factory factory)
 {
-	Factories[std::string(type)] = std::move(factory);
+	Factories[std::string(type)] = Registration{ typeId, std::move(factory) };
 }
 
-const ComponentRegistry::Factory* ComponentRegistry::Find(std::string_view type) const
+const ComponentRegistry::Registration* ComponentRegistry::Find(std::string_view type) const
 {
 	auto iter = Factories.find(std::string(type));
 	if (iter == Factories.end()) {
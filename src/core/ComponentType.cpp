@@ -0,0 +1,30 @@
+#include <core/ComponentType.h>
+#include <array>
+#include <cassert>
+#include <mutex>
+
+namespace {
+	std::array<ComponentTypeInfo, MaxComponentTypes>& TypeInfos()
+	{
+		static std::array<ComponentTypeInfo, MaxComponentTypes> infos;
+		return infos;
+	}
+}
+
+ComponentTypeId ComponentType::Register(const ComponentTypeInfo& info)
+{
+	static std::mutex registerMutex;
+	static ComponentTypeId counter = 0;
+
+	std::lock_guard<std::mutex> lock(registerMutex);
+	const ComponentTypeId id = counter++;
+	assert(id < MaxComponentTypes && "Raise MaxComponentTypes");
+	TypeInfos()[id] = info;
+	return id;
+}
+
+const ComponentTypeInfo& ComponentType::GetInfo(ComponentTypeId id)
+{
+	assert(id < MaxComponentTypes);
+	return TypeInfos()[id];
+}
@@ -0,0 +1,294 @@
+#include <core/DynamicAabbTree.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace {
+	Rectf Union(const Rectf& _a, const Rectf& _b)
+	{
+		const float _left = std::min(_a.Left(), _b.Left());
+		const float _top = std::min(_a.Top(), _b.Top());
+		const float _right = std::max(_a.Right(), _b.Right());
+		const float _bottom = std::max(_a.Bottom(), _b.Bottom());
+		return Rectf(_left, _top, _right - _left, _bottom - _top);
+	}
+
+	float Perimeter(const Rectf& _rect)
+	{
+		return 2.0f * (_rect.width + _rect.height);
+	}
+
+	bool ContainsRect(const Rectf& _outer, const Rectf& _inner)
+	{
+		return _inner.Left() >= _outer.Left()
+			&& _inner.Right() <= _outer.Right()
+			&& _inner.Top() >= _outer.Top()
+			&& _inner.Bottom() <= _outer.Bottom();
+	}
+
+	Rectf Fatten(const Rectf& _bounds, float _margin)
+	{
+		return Rectf(_bounds.x - _margin, _bounds.y - _margin, _bounds.width + 2.0f * _margin, _bounds.height + 2.0f * _margin);
+	}
+}
+
+DynamicAabbTree::DynamicAabbTree(float _margin)
+	: Margin(_margin)
+{
+}
+
+int32_t DynamicAabbTree::CreateProxy(const Rectf& _bounds, EntityHandle _entity, CollisionLayerMask _layers)
+{
+	const int32_t _proxy = AllocateNode();
+	Node& _node = Nodes[_proxy];
+	_node.Bounds = Fatten(_bounds, Margin);
+	_node.Entity = _entity;
+	_node.Layers = _layers;
+	_node.Height = 0;
+	InsertLeaf(_proxy);
+	return _proxy;
+}
+
+void DynamicAabbTree::DestroyProxy(int32_t _proxy)
+{
+	assert(_proxy >= 0 && _proxy < static_cast<int32_t>(Nodes.size()) && Nodes[_proxy].IsLeaf());
+	RemoveLeaf(_proxy);
+	FreeNode(_proxy);
+}
+
+bool DynamicAabbTree::MoveProxy(int32_t _proxy, const Rectf& _bounds)
+{
+	assert(_proxy >= 0 && _proxy < static_cast<int32_t>(Nodes.size()) && Nodes[_proxy].IsLeaf());
+	if (ContainsRect(Nodes[_proxy].Bounds, _bounds)) {
+		return false;
+	}
+	RemoveLeaf(_proxy);
+	Nodes[_proxy].Bounds = Fatten(_bounds, Margin);
+	InsertLeaf(_proxy);
+	return true;
+}
+
+void DynamicAabbTree::SetProxyLayers(int32_t _proxy, CollisionLayerMask _layers)
+{
+	if (Nodes[_proxy].Layers == _layers) {
+		return;
+	}
+	Nodes[_proxy].Layers = _layers;
+	for (int32_t _index = Nodes[_proxy].Parent; _index != NullNode; _index = Nodes[_index].Parent) {
+		Nodes[_index].Layers = Nodes[Nodes[_index].Child1].Layers | Nodes[Nodes[_index].Child2].Layers;
+	}
+}
+
+void DynamicAabbTree::Clear()
+{
+	Nodes.clear();
+	Root = NullNode;
+	FreeList = NullNode;
+}
+
+void DynamicAabbTree::Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const
+{
+	if (Root == NullNode) {
+		return;
+	}
+
+	// Nodes are tested before they are pushed, so the stack only holds overlapping subtrees.
+	auto _overlaps = [&_range, _layerMask](const Node& _node) {
+		return (_node.Layers & _layerMask) != 0 && _node.Bounds.Intersects(_range);
+	};
+	if (!_overlaps(Nodes[Root])) {
+		return;
+	}
+
+	// Rotations keep the height near 1.44 * log2(n), far below the stack size.
+	std::array<int32_t, 256> _stack;
+	size_t _top = 0;
+	_stack[_top++] = Root;
+
+	while (_top > 0) {
+		const Node& _node = Nodes[_stack[--_top]];
+		if (_node.IsLeaf()) {
+			_found.push_back(_node.Entity);
+			continue;
+		}
+		assert(_top + 2 <= _stack.size());
+		if (_overlaps(Nodes[_node.Child1])) {
+			_stack[_top++] = _node.Child1;
+		}
+		if (_overlaps(Nodes[_node.Child2])) {
+			_stack[_top++] = _node.Child2;
+		}
+	}
+}
+
+int32_t DynamicAabbTree::AllocateNode()
+{
+	if (FreeList == NullNode) {
+		Nodes.emplace_back();
+		return static_cast<int32_t>(Nodes.size() - 1);
+	}
+	const int32_t _node = FreeList;
+	FreeList = Nodes[_node].Parent;
+	Nodes[_node] = Node();
+	return _node;
+}
+
+void DynamicAabbTree::FreeNode(int32_t _node)
+{
+	Nodes[_node].Parent = FreeList;
+	Nodes[_node].Height = -1;
+	FreeList = _node;
+}
+
+void DynamicAabbTree::InsertLeaf(int32_t _leaf)
+{
+	if (Root == NullNode) {
+		Root = _leaf;
+		Nodes[_leaf].Parent = NullNode;
+		return;
+	}
+
+	// Descend towards the sibling with the lowest perimeter cost (surface area heuristic in 2D).
+	const Rectf _leafBounds = Nodes[_leaf].Bounds;
+	int32_t _index = Root;
+	while (!Nodes[_index].IsLeaf()) {
+		const Node& _node = Nodes[_index];
+		const float _area = Perimeter(_node.Bounds);
+		const float _combinedArea = Perimeter(Union(_node.Bounds, _leafBounds));
+
+		// Cost of making a new parent for this node and the leaf, and the cost pushed down to
+		// whichever child we descend into.
+		const float _cost = 2.0f * _combinedArea;
+		const float _inheritance = 2.0f * (_combinedArea - _area);
+
+		auto _childCost = [this, &_leafBounds, _inheritance](int32_t _child) {
+			const Node& _childNode = Nodes[_child];
+			const float _enlarged = Perimeter(Union(_childNode.Bounds, _leafBounds));
+			return _childNode.IsLeaf() ? _enlarged + _inheritance
+				: (_enlarged - Perimeter(_childNode.Bounds)) + _inheritance;
+		};
+		const float _cost1 = _childCost(_node.Child1);
+		const float _cost2 = _childCost(_node.Child2);
+
+		if (_cost < _cost1 && _cost < _cost2) {
+			break;
+		}
+		_index = _cost1 < _cost2 ? _node.Child1 : _node.Child2;
+	}
+
+	const int32_t _sibling = _index;
+	const int32_t _oldParent = Nodes[_sibling].Parent;
+	const int32_t _newParent = AllocateNode();
+	Nodes[_newParent].Parent = _oldParent;
+	Nodes[_newParent].Child1 = _sibling;
+	Nodes[_newParent].Child2 = _leaf;
+	Nodes[_sibling].Parent = _newParent;
+	Nodes[_leaf].Parent = _newParent;
+	Refit(_newParent);
+
+	if (_oldParent == NullNode) {
+		Root = _newParent;
+	} else if (Nodes[_oldParent].Child1 == _sibling) {
+		Nodes[_oldParent].Child1 = _newParent;
+	} else {
+		Nodes[_oldParent].Child2 = _newParent;
+	}
+
+	RefitAncestors(Nodes[_leaf].Parent);
+}
+
+void DynamicAabbTree::RemoveLeaf(int32_t _leaf)
+{
+	if (_leaf == Root) {
+		Root = NullNode;
+		return;
+	}
+
+	const int32_t _parent = Nodes[_leaf].Parent;
+	const int32_t _grandParent = Nodes[_parent].Parent;
+	const int32_t _sibling = Nodes[_parent].Child1 == _leaf ? Nodes[_parent].Child2 : Nodes[_parent].Child1;
+
+	if (_grandParent == NullNode) {
+		Root = _sibling;
+		Nodes[_sibling].Parent = NullNode;
+		FreeNode(_parent);
+		return;
+	}
+
+	if (Nodes[_grandParent].Child1 == _parent) {
+		Nodes[_grandParent].Child1 = _sibling;
+	} else {
+		Nodes[_grandParent].Child2 = _sibling;
+	}
+	Nodes[_sibling].Parent = _grandParent;
+	FreeNode(_parent);
+
+	RefitAncestors(_grandParent);
+}
+
+void DynamicAabbTree::RefitAncestors(int32_t _node)
+{
+	for (int32_t _index = _node; _index != NullNode; _index = Nodes[_index].Parent) {
+		_index = Balance(_index);
+		Refit(_index);
+	}
+}
+
+void DynamicAabbTree::Refit(int32_t _node)
+{
+	Node& _parent = Nodes[_node];
+	const Node& _child1 = Nodes[_parent.Child1];
+	const Node& _child2 = Nodes[_parent.Child2];
+	_parent.Bounds = Union(_child1.Bounds, _child2.Bounds);
+	_parent.Layers = _child1.Layers | _child2.Layers;
+	_parent.Height = 1 + std::max(_child1.Height, _child2.Height);
+}
+
+// Rotates the taller grandchild of an unbalanced node up one level and returns the
+// subtree's new root.
+int32_t DynamicAabbTree::Balance(int32_t _a)
+{
+	if (Nodes[_a].IsLeaf() || Nodes[_a].Height < 2) {
+		return _a;
+	}
+
+	const int32_t _b = Nodes[_a].Child1;
+	const int32_t _c = Nodes[_a].Child2;
+	const int32_t _balance = Nodes[_c].Height - Nodes[_b].Height;
+	if (_balance >= -1 && _balance <= 1) {
+		return _a;
+	}
+
+	// _up is the taller child; it takes _a's place and _a adopts one of its children.
+	const bool _rightHeavy = _balance > 1;
+	const int32_t _up = _rightHeavy ? _c : _b;
+	const int32_t _upChild1 = Nodes[_up].Child1;
+	const int32_t _upChild2 = Nodes[_up].Child2;
+	const bool _keepFirst = Nodes[_upChild1].Height > Nodes[_upChild2].Height;
+	const int32_t _kept = _keepFirst ? _upChild1 : _upChild2;
+	const int32_t _moved = _keepFirst ? _upChild2 : _upChild1;
+
+	const int32_t _parent = Nodes[_a].Parent;
+	Nodes[_up].Parent = _parent;
+	if (_parent == NullNode) {
+		Root = _up;
+	} else if (Nodes[_parent].Child1 == _a) {
+		Nodes[_parent].Child1 = _up;
+	} else {
+		Nodes[_parent].Child2 = _up;
+	}
+
+	Nodes[_up].Child1 = _a;
+	Nodes[_up].Child2 = _kept;
+	Nodes[_a].Parent = _up;
+	if (_rightHeavy) {
+		Nodes[_a].Child2 = _moved;
+	} else {
+		Nodes[_a].Child1 = _moved;
+	}
+	Nodes[_moved].Parent = _a;
+
+	Refit(_a);
+	Refit(_up);
+	return _up;
+}
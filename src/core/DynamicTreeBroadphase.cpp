@@ -0,0 +1,68 @@
+#include <core/DynamicTreeBroadphase.h>
+#include <algorithm>
+
+DynamicTreeBroadphase::DynamicTreeBroadphase(float _margin)
+	: Tree(_margin)
+{
+}
+
+void DynamicTreeBroadphase::Update(const std::vector<BroadphaseProxy>& _proxies)
+{
+	Proxies = _proxies;
+	++SyncStamp;
+	for (size_t _index = 0; _index < Proxies.size(); ++_index) {
+		const BroadphaseProxy& _proxy = Proxies[_index];
+		const EntityHandle _handle = _proxy.Handle;
+		if (_handle.Index >= Slots.size()) {
+			Slots.resize(_handle.Index + 1);
+		}
+		TreeProxy& _slot = Slots[_handle.Index];
+		// A reused handle slot still holding the previous entity's leaf.
+		if (_slot.Node != DynamicAabbTree::NullNode && _slot.Generation != _handle.Generation) {
+			Tree.DestroyProxy(_slot.Node);
+			_slot.Node = DynamicAabbTree::NullNode;
+		}
+		if (_slot.Node == DynamicAabbTree::NullNode) {
+			_slot.Node = Tree.CreateProxy(_proxy.Bounds, _handle, _proxy.Layers);
+			_slot.Generation = _handle.Generation;
+		} else {
+			Tree.MoveProxy(_slot.Node, _proxy.Bounds);
+			Tree.SetProxyLayers(_slot.Node, _proxy.Layers);
+		}
+		_slot.LastSync = SyncStamp;
+		_slot.Proxy = static_cast<uint32_t>(_index);
+	}
+
+	// Entities that were disabled or destroyed since the last tick.
+	for (auto& _slot : Slots) {
+		if (_slot.Node != DynamicAabbTree::NullNode && _slot.LastSync != SyncStamp) {
+			Tree.DestroyProxy(_slot.Node);
+			_slot.Node = DynamicAabbTree::NullNode;
+		}
+	}
+}
+
+void DynamicTreeBroadphase::Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const
+{
+	Tree.Query(_range, _layerMask, _found);
+}
+
+void DynamicTreeBroadphase::FindPairsInRange(size_t _begin, size_t _end, std::vector<BroadphasePair>& _pairs) const
+{
+	// Leaves hold fat bounds, so candidates are re-tested against the exact ones.
+	const size_t _first = _pairs.size();
+	FindPairsByQuery(Proxies, _begin, _end, _pairs);
+	const auto _exact = std::remove_if(_pairs.begin() + _first, _pairs.end(), [this](const BroadphasePair& _pair) {
+		const Rectf& _a = Proxies[Slots[_pair.First.Index].Proxy].Bounds;
+		const Rectf& _b = Proxies[Slots[_pair.Second.Index].Proxy].Bounds;
+		return !_a.Intersects(_b);
+	});
+	_pairs.erase(_exact, _pairs.end());
+}
+
+void DynamicTreeBroadphase::Clear()
+{
+	Tree.Clear();
+	Slots.clear();
+	Proxies.clear();
+}
@@ -2,16 +2,24 @@
 #include <core/engine/GameServiceHost.h>
 #include <core/engine/RenderService.h>
 #include <core/Camera.h>
+#include <core/World.h>
+#include <cassert>
 
 
 Entity::Entity(GameServiceHost& _services, std::string _texture, float _width, float _height)
 	:Position(0,0),
+	PreviousPosition(0,0),
+	ComponentSlots{},
+	Tag(player),
+	CollisionLayers(LayerOf(player)),
+	Static(false),
 	Activated(true),
 	Services(_services)
 {
 	//load resource handler from service
 	auto& _handler = Services.Get<RenderService>().GetTextureHandler();
 	Sprite.SetTexture(_handler.Get(_texture));
+	Sprite.SetCollisionMask(_handler.GetMask(_texture));
 	Sprite.SetTextureRect(Recti(0, 0, static_cast<int>(_width), static_cast<int>(_height)));
 }
 
@@ -20,8 +28,25 @@ Entity::~Entity()
 {
 }
 
-void Entity::AttachComponent(std::unique_ptr<Component> _comp)
+void Entity::AttachComponent(std::unique_ptr<Component> _comp, ComponentTypeId _typeId)
 {
+	assert(_typeId < MaxComponentTypes);
+	_comp->TypeId = _typeId;
+	_comp->Active = Activated;
+	if (!ComponentTypes.test(_typeId)) {
+		ComponentSlots[_typeId] = _comp.get();
+		ComponentTypes.set(_typeId);
+	}
+	const uint32_t _phases = ComponentType::GetInfo(_typeId).Phases;
+	if (_phases & ComponentPhaseCollisionEnter) {
+		CollisionEnterListeners.push_back(_comp.get());
+	}
+	if (_phases & ComponentPhaseCollisionStay) {
+		CollisionStayListeners.push_back(_comp.get());
+	}
+	if (_phases & ComponentPhaseCollisionExit) {
+		CollisionExitListeners.push_back(_comp.get());
+	}
 	Components.push_back(std::move(_comp));
 }
 
@@ -52,6 +77,51 @@ void Entity::PostUpdateComponents()
 	}
 }
 
+void Entity::Enable()
+{
+	Activated = true;
+	for (auto& _component : Components) {
+		_component->Active = true;
+	}
+	if (OwnerWorld) {
+		OwnerWorld->NotifyStateChanged(*this);
+	}
+	Start();
+}
+
+void Entity::Disable()
+{
+	if (!Activated) {
+		return;
+	}
+	Activated = false;
+	for (auto& _component : Components) {
+		_component->Active = false;
+		_component->OnDisable();
+	}
+	if (OwnerWorld) {
+		OwnerWorld->NotifyStateChanged(*this);
+	}
+	if (ReleaseListener) {
+		ReleaseListener->OnEntityReleased(*this, ReleaseTicket);
+	}
+}
+
+size_t Entity::GetMemoryFootprint() const
+{
+	size_t _bytes = sizeof(Entity);
+	_bytes += Components.capacity() * sizeof(Components[0]);
+	for (const auto& _component : Components) {
+		_bytes += ComponentType::GetInfo(_component->GetTypeId()).Size;
+	}
+	_bytes += (CollisionEnterListeners.capacity() + CollisionStayListeners.capacity()
+		+ CollisionExitListeners.capacity()) * sizeof(Component*);
+	if (Animator) {
+		_bytes += sizeof(AnimationStateMachine);
+	}
+	return _bytes;
+}
+
 void Entity::Start()
 {
 	StartComponents();
@@ -70,18 +140,24 @@ void Entity::PostUpdate()
 {
 	if (Activated) {
 		PostUpdateComponents();
+		UpdateAnimator();
+	}
+}
 
-		if (Animator != nullptr) {
-			Animator->Update(Sprite);
-		}
+void Entity::UpdateAnimator()
+{
+	if (Animator != nullptr) {
+		Animator->Update(Sprite);
 	}
 }
 
-void Entity::Render(SDL_Renderer* _renderer, Camera* _camera)
+void Entity::Render(SDL_Renderer* _renderer, Camera* _camera, float _alpha)
 {
 	if (Activated) {
-		Sprite.SetPosition(Position);
+		Sprite.SetPosition(GetInterpolatedPosition(_alpha));
 		Sprite.Render(_renderer, _camera);
+		//the sprite also provides collision bounds, so put it back on the simulated position
+		Sprite.SetPosition(Position);
 	}
 }
 
@@ -113,11 +189,29 @@ void Entity::AssignAnimator(std::unique_ptr<AnimationStateMachine> _animator)
 	Animator = std::move(_animator);
 }
 
-void Entity::OnCollide(Entity& _other)
+void Entity::OnCollisionEnter(Entity& _other)
 {
 	if (Activated) {
-		for (auto& _component : Components) {
-			_component->OnCollide(_other);
+		for (auto* _component : CollisionEnterListeners) {
+			_component->OnCollisionEnter(_other);
+		}
+	}
+}
+
+void Entity::OnCollisionStay(Entity& _other)
+{
+	if (Activated) {
+		for (auto* _component : CollisionStayListeners) {
+			_component->OnCollisionStay(_other);
+		}
+	}
+}
+
+void Entity::OnCollisionExit(Entity& _other)
+{
+	if (Activated) {
+		for (auto* _component : CollisionExitListeners) {
+			_component->OnCollisionExit(_other);
 		}
 	}
 }
@@ -0,0 +1,120 @@
+#include <core/PixelMask.h>
+#include <core/Sprite.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	// Column of the mask (or its mirror) that world column `_x` of the placement shows.
+	int TextureColumn(const PixelMask::Placement& _placement, int _x)
+	{
+		const int _local = _x - _placement.X;
+		if (_placement.FlipX) {
+			// Flipping the frame in place is reading its mirror image in the mirrored texture.
+			return _placement.Mask->GetWidth() - _placement.Frame.x - _placement.Frame.width + _local;
+		}
+		return _placement.Frame.x + _local;
+	}
+
+	PixelMask::Placement PlacementOf(const Sprite& _sprite)
+	{
+		const SDL_FRect& _dest = _sprite.GetDestRect();
+		// Frames draw 1:1, so whole world pixels line up with texture pixels.
+		return {
+			_sprite.GetCollisionMask(),
+			_sprite.GetTextureRect(),
+			_sprite.IsFlippedX(),
+			static_cast<int>(std::floor(_dest.x)),
+			static_cast<int>(std::floor(_dest.y)),
+		};
+	}
+}
+
+PixelMask PixelMask::FromSurface(SDL_Surface* _surface, uint8_t _alphaThreshold)
+{
+	PixelMask _mask;
+	SDL_Surface* _rgba = SDL_ConvertSurface(_surface, SDL_PIXELFORMAT_RGBA32);
+	if (!_rgba) {
+		return _mask;
+	}
+	if (SDL_LockSurface(_rgba)) {
+		_mask.Width = _rgba->w;
+		_mask.Height = _rgba->h;
+		_mask.WordsPerRow = (_rgba->w + 63) / 64;
+		_mask.Bits.assign(static_cast<size_t>(_mask.WordsPerRow) * _rgba->h, 0);
+		_mask.MirroredBits.assign(_mask.Bits.size(), 0);
+		for (int _y = 0; _y < _rgba->h; ++_y) {
+			const uint8_t* _pixels = static_cast<const uint8_t*>(_rgba->pixels) + static_cast<size_t>(_y) * _rgba->pitch;
+			uint64_t* _row = _mask.Bits.data() + static_cast<size_t>(_y) * _mask.WordsPerRow;
+			uint64_t* _mirroredRow = _mask.MirroredBits.data() + static_cast<size_t>(_y) * _mask.WordsPerRow;
+			for (int _x = 0; _x < _rgba->w; ++_x) {
+				//RGBA32 is byte ordered, so alpha is the fourth byte whatever the endianness
+				if (_pixels[_x * 4 + 3] >= _alphaThreshold) {
+					const int _mirroredX = _rgba->w - 1 - _x;
+					_row[_x >> 6] |= uint64_t(1) << (_x & 63);
+					_mirroredRow[_mirroredX >> 6] |= uint64_t(1) << (_mirroredX & 63);
+				}
+			}
+		}
+		SDL_UnlockSurface(_rgba);
+	}
+	SDL_DestroySurface(_rgba);
+	return _mask;
+}
+
+uint64_t PixelMask::GetRow64(int _x, int _y, bool _mirrored) const
+{
+	if (_y < 0 || _y >= Height || _x >= Width || _x <= -64) {
+		return 0;
+	}
+	if (_x < 0) {
+		return GetRow64(0, _y, _mirrored) << -_x;
+	}
+	const uint64_t* _row = (_mirrored ? MirroredBits : Bits).data() + static_cast<size_t>(_y) * WordsPerRow;
+	const int _word = _x >> 6;
+	const int _shift = _x & 63;
+	// Bits past the row's width are always clear, so the last word needs no masking.
+	uint64_t _bits = _row[_word] >> _shift;
+	if (_shift != 0 && _word + 1 < WordsPerRow) {
+		_bits |= _row[_word + 1] << (64 - _shift);
+	}
+	return _bits;
+}
+
+bool PixelMask::Overlap(const Placement& _a, const Placement& _b)
+{
+	const int _left = std::max(_a.X, _b.X);
+	const int _right = std::min(_a.X + _a.Frame.width, _b.X + _b.Frame.width);
+	const int _top = std::max(_a.Y, _b.Y);
+	const int _bottom = std::min(_a.Y + _a.Frame.height, _b.Y + _b.Frame.height);
+	if (_left >= _right || _top >= _bottom) {
+		return false;
+	}
+
+	for (int _y = _top; _y < _bottom; ++_y) {
+		const int _rowA = _a.Frame.y + (_y - _a.Y);
+		const int _rowB = _b.Frame.y + (_y - _b.Y);
+		for (int _x = _left; _x < _right; _x += 64) {
+			uint64_t _bits = _a.Mask->GetRow64(TextureColumn(_a, _x), _rowA, _a.FlipX)
+				& _b.Mask->GetRow64(TextureColumn(_b, _x), _rowB, _b.FlipX);
+			//the last run can reach past the overlap into pixels of a neighbouring frame
+			const int _run = _right - _x;
+			if (_run < 64) {
+				_bits &= (uint64_t(1) << _run) - 1;
+			}
+			if (_bits != 0) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool PixelMask::SpritesOverlap(const Sprite& _a, const Sprite& _b)
+{
+	const PixelMask* _maskA = _a.GetCollisionMask();
+	const PixelMask* _maskB = _b.GetCollisionMask();
+	if (!_maskA || !_maskB || _maskA->IsEmpty() || _maskB->IsEmpty()) {
+		return true;
+	}
+	return Overlap(PlacementOf(_a), PlacementOf(_b));
+}
@@ -3,6 +3,7 @@
 #include <core/engine/GameServiceHost.h>
 #include <core/Json.h>
 #include <core/ResourceHandler.h>
+#include <algorithm>
 #include <cassert>
 
 namespace {
@@ -26,14 +27,130 @@ namespace {
 		return true;
 	}
 
+	bool TryParseTag(std::string_view value, ENTITY_TAG& out)
+	{
+		if (value == "player") { out = player; return true; }
+		if (value == "bullet") { out = bullet; return true; }
+		if (value == "enemy_bullet") { out = enemy_bullet; return true; }
+		if (value == "hazard") { out = hazard; return true; }
+		if (value == "pickup") { out = pickup; return true; }
+		return false;
+	}
+
 	ENTITY_TAG ParseTag(std::string_view value)
 	{
-		if (value == "player") return player;
-		if (value == "bullet") return bullet;
-		if (value == "enemy_bullet") return enemy_bullet;
-		if (value == "hazard") return hazard;
-		if (value == "pickup") return pickup;
-		return player;
+		ENTITY_TAG tag = player;
+		TryParseTag(value, tag);
+		return tag;
+	}
+
+	bool TryParseCollisionEvent(std::string_view value, CollisionEvent& out)
+	{
+		if (value == "enter") { out = CollisionEvent::Enter; return true; }
+		if (value == "stay") { out = CollisionEvent::Stay; return true; }
+		if (value == "exit") { out = CollisionEvent::Exit; return true; }
+		return false;
+	}
+
+	//{"self": tag, "other": tag, "event": "enter" or ["enter", "stay"], "handler": name}
+	void ParseCollisionResponses(simdjson::dom::element root, std::vector<CollisionResponseDefinition>& responses)
+	{
+		auto rows = root["collisionResponses"].get_array();
+		if (rows.error()) {
+			return;
+		}
+		for (auto row : rows.value()) {
+			CollisionResponseDefinition definition;
+			auto self = row["self"].get_string();
+			auto other = row["other"].get_string();
+			auto handler = row["handler"].get_string();
+			if (self.error() || other.error() || handler.error()
+				|| !TryParseTag(self.value(), definition.Self) || !TryParseTag(other.value(), definition.Other)) {
+				SDL_Log("PrefabSystem: Skipping malformed collision response.");
+				continue;
+			}
+			definition.Handler = std::string(handler.value());
+
+			std::vector<std::string_view> eventNames;
+			auto event = row["event"];
+			auto eventName = event.get_string();
+			auto eventList = event.get_array();
+			if (!eventName.error()) {
+				eventNames.push_back(eventName.value());
+			} else if (!eventList.error()) {
+				for (auto name : eventList.value()) {
+					auto listed = name.get_string();
+					eventNames.push_back(listed.error() ? std::string_view() : listed.value());
+				}
+			} else {
+				eventNames.push_back("enter");
+			}
+			for (const auto name : eventNames) {
+				if (!TryParseCollisionEvent(name, definition.Event)) {
+					SDL_Log("PrefabSystem: Unknown collision event for handler '%s'.", definition.Handler.c_str());
+					continue;
+				}
+				responses.push_back(definition);
+			}
+		}
+	}
+
+	bool TryParseLayer(std::string_view value, CollisionLayerMask& out)
+	{
+		if (value == "player") { out = LayerOf(player); return true; }
+		if (value == "bullet") { out = LayerOf(bullet); return true; }
+		if (value == "enemy_bullet") { out = LayerOf(enemy_bullet); return true; }
+		if (value == "hazard") { out = LayerOf(hazard); return true; }
+		if (value == "pickup") { out = LayerOf(pickup); return true; }
+		return false;
+	}
+
+	//"collisionLayers" is either a list of layer names or a raw bitmask
+	void ParseCollisionLayers(simdjson::dom::element prefab, PrefabDefinition& definition)
+	{
+		auto layers = prefab["collisionLayers"];
+		if (layers.error()) {
+			return;
+		}
+		auto mask = layers.get_uint64();
+		if (!mask.error()) {
+			definition.CollisionLayers = static_cast<CollisionLayerMask>(mask.value());
+			return;
+		}
+		auto names = layers.get_array();
+		if (names.error()) {
+			return;
+		}
+		for (auto name : names.value()) {
+			auto layerName = name.get_string();
+			CollisionLayerMask layer = 0;
+			if (!layerName.error() && TryParseLayer(layerName.value(), layer)) {
+				definition.CollisionLayers |= layer;
+			} else {
+				SDL_Log("PrefabSystem: Unknown collision layer in prefab '%s'.", definition.Id.c_str());
+			}
+		}
+	}
+
+	void ParsePool(simdjson::dom::element prefab, PrefabDefinition& definition)
+	{
+		auto result = prefab["pool"];
+		if (result.error() || result.value().type() != simdjson::dom::element_type::OBJECT) {
+			return;
+		}
+		simdjson::dom::element pool = result.value();
+		PoolDefinition& settings = definition.Pool;
+		settings.Declared = true;
+		settings.Initial = static_cast<size_t>(std::max<int64_t>(0, Json::GetInt(pool, "initial", 0)));
+		settings.Max = static_cast<size_t>(std::max<int64_t>(0, Json::GetInt(pool, "max", 0)));
+		settings.Growth = static_cast<float>(Json::GetDouble(pool, "growth", settings.Growth));
+		if (settings.Growth < 1.0f) {
+			SDL_Log("PrefabSystem: Pool growth below 1 in prefab '%s', using 1.", definition.Id.c_str());
+			settings.Growth = 1.0f;
+		}
+		if (settings.Max != 0 && settings.Initial > settings.Max) {
+			SDL_Log("PrefabSystem: Pool of prefab '%s' starts above its max.", definition.Id.c_str());
+		}
 	}
 
 	void ParseAnimations(simdjson::dom::element prefab, PrefabDefinition& definition)
@@ -51,6 +168,7 @@ namespace {
 			auto name = anim["name"].get_string();
 			if (!name.error()) {
 				animDef.Name = std::string(name.value());
+				animDef.Id = StringId::Intern(animDef.Name);
 			}
 
 			auto index = anim["index"].get_int64();
@@ -147,6 +265,7 @@ bool PrefabSystem::LoadFromFile(const std::string& path)
 	}
 
 	Clear();
+	ParseCollisionResponses(root, CollisionResponses);
 
 	for (auto prefab : prefabs.value()) {
 		if (prefab.type() != simdjson::dom::element_type::OBJECT) {
@@ -185,11 +304,18 @@ bool PrefabSystem::LoadFromFile(const std::string& path)
 			definition.Tag = ParseTag(tag.value());
 		}
 
+		auto isStatic = prefab["static"].get_bool();
+		if (!isStatic.error()) {
+			definition.Static = isStatic.value();
+		}
+
+		ParseCollisionLayers(prefab, definition);
 		ParseAnimations(prefab, definition);
 		ParseComponents(prefab, definition);
+		ParsePool(prefab, definition);
 
 		if (!definition.Id.empty()) {
-			Definitions.emplace(definition.Id, std::move(definition));
+			Definitions.emplace(StringId::Intern(definition.Id), std::move(definition));
 		}
 	}
 
@@ -210,13 +336,28 @@ bool PrefabSystem::LoadFromFile(const std::string& path, ResourceHandler& textur
 
 const PrefabDefinition* PrefabSystem::Find(std::string_view id) const
 {
-	auto iter = Definitions.find(std::string(id));
+	return Find(StringId(id));
+}
+
+const PrefabDefinition* PrefabSystem::Find(StringId id) const
+{
+	auto iter = Definitions.find(id);
 	if (iter == Definitions.end()) {
 		return nullptr;
 	}
 	return &iter->second;
 }
 
+std::vector<const PrefabDefinition*> PrefabSystem::GetDefinitions() const
+{
+	std::vector<const PrefabDefinition*> definitions;
+	definitions.reserve(Definitions.size());
+	for (const auto& pair : Definitions) {
+		definitions.push_back(&pair.second);
+	}
+	return definitions;
+}
+
 std::unique_ptr<Entity> PrefabSystem::Instantiate(std::string_view id) const
 {
 	const PrefabDefinition* definition = Find(id);
@@ -240,22 +381,26 @@ std::unique_ptr<Entity> PrefabSystem::Instantiate(const PrefabDefinition& defini
 				frameSize = Vec2(definition.Width, definition.Height);
 			}
 			auto animPtr = std::make_unique<Animation>(animDef.Index, frameSize, animDef.Frames, animDef.Loop, animDef.Priority);
-			anim->AddAnimation(animDef.Name, std::move(animPtr));
+			anim->AddAnimation(animDef.Id, std::move(animPtr));
 		}
 		entity->AssignAnimator(std::move(anim));
 	}
 
 	for (const auto& component : definition.Components) {
-		const auto* factory = Registry.Find(component.Type);
-		if (factory) {
-			auto comp = (*factory)(*entity, *Services, component.ParamsJson);
+		const auto* registration = Registry.Find(component.Type);
+		if (registration) {
+			auto comp = registration->Create(*entity, *Services, component.ParamsJson);
 			if (comp) {
-				entity->AttachComponent(std::move(comp));
+				entity->AttachComponent(std::move(comp), registration->TypeId);
 			}
 		}
 	}
 
 	entity->SetTag(definition.Tag);
+	if (definition.CollisionLayers != 0) {
+		entity->SetCollisionLayers(definition.CollisionLayers);
+	}
+	entity->SetStatic(definition.Static);
 	entity->SetPosition(definition.Position);
 	return entity;
 }
@@ -278,4 +423,5 @@ size_t PrefabSystem::Count() const
 void PrefabSystem::Clear()
 {
 	Definitions.clear();
+	CollisionResponses.clear();
 }
@@ -1,94 +1,153 @@
 #include <core/QuadTree.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
 
-QuadTree::QuadTree(const Rectf& _bounds, int _capacity, int _maxDepth, int _depth)
+QuadTree::QuadTree(const Rectf& _bounds, int _capacity, int _maxDepth)
 	: Bounds(_bounds),
 	Capacity(_capacity),
-	MaxDepth(_maxDepth),
-	Depth(_depth)
+	MaxDepth(std::min(_maxDepth, MaxDepthLimit))
 {
 }
 
 void QuadTree::Clear()
 {
-	Items.clear();
-	for (auto& _child : Children) {
-		_child.reset();
-	}
+	Nodes.clear();
+	Pending.clear();
+	ItemHandles.clear();
+	ItemBounds.Clear();
+	Built = false;
 }
 
-void QuadTree::Insert(Entity* _entity)
+void QuadTree::Insert(EntityHandle _entity, const Rectf& _bounds, CollisionLayerMask _layers)
 {
-	const Rectf _bounds = _entity->GetBoundingRect();
 	if (!Bounds.Intersects(_bounds)) {
 		return;
 	}
+	Pending.push_back({ _entity, _bounds, _layers });
+	Built = false;
+}
 
-	if (Children[0] && InsertIntoChild(_entity)) {
-		return;
+void QuadTree::Build()
+{
+	// Pending items are partitioned in place, then copied out grouped by node. Items from an
+	// earlier Build are re-inserted so Insert after Build still keeps them.
+	for (size_t _index = 0; _index < ItemHandles.size(); ++_index) {
+		const Rectf _bounds(ItemBounds.MinX[_index], ItemBounds.MinY[_index],
+			ItemBounds.MaxX[_index] - ItemBounds.MinX[_index], ItemBounds.MaxY[_index] - ItemBounds.MinY[_index]);
+		Pending.push_back({ ItemHandles[_index], _bounds, ItemBounds.Layers[_index] });
 	}
+	ItemHandles.clear();
+	ItemBounds.Clear();
+	Nodes.clear();
+	Tasks.clear();
 
-	Items.push_back(_entity);
+	Node _root;
+	_root.Bounds = Bounds;
+	Nodes.push_back(_root);
+	Tasks.push_back({ 0, 0, static_cast<uint32_t>(Pending.size()), 0 });
 
-	if (Items.size() > static_cast<size_t>(Capacity) && Depth < MaxDepth) {
-		if (!Children[0]) {
-			Subdivide();
-		}
-		auto _iter = Items.begin();
-		while (_iter != Items.end()) {
-			if (InsertIntoChild(*_iter)) {
-				_iter = Items.erase(_iter);
-			} else {
-				++_iter;
+	while (!Tasks.empty()) {
+		const BuildTask _task = Tasks.back();
+		Tasks.pop_back();
+
+		auto _begin = Pending.begin() + _task.Begin;
+		auto _end = Pending.begin() + _task.End;
+		auto _stayEnd = _end;
+		uint32_t _firstChild = 0;
+
+		if (_task.End - _task.Begin > static_cast<uint32_t>(Capacity) && _task.Depth < MaxDepth) {
+			_firstChild = Subdivide(_task.Node);
+			const Node* _children = &Nodes[_firstChild];
+			// Only the quadrant holding the item's top-left corner can contain it.
+			auto _childOf = [_children](const Item& _item) {
+				const Rectf& _split = _children[3].Bounds;
+				const int _child = (_item.Bounds.x >= _split.x ? 1 : 0) + (_item.Bounds.y >= _split.y ? 2 : 0);
+				return ContainsRect(_children[_child].Bounds, _item.Bounds) ? _child : -1;
+			};
+
+			// Items that straddle a split line stay on this node.
+			_stayEnd = std::partition(_begin, _end, [&_childOf](const Item& _item) {
+				return _childOf(_item) < 0;
+			});
+
+			auto _childBegin = _stayEnd;
+			for (int _child = 0; _child < 4; ++_child) {
+				auto _childEnd = std::partition(_childBegin, _end, [&_childOf, _child](const Item& _item) {
+					return _childOf(_item) == _child;
+				});
+				if (_childEnd != _childBegin) {
+					Tasks.push_back({ _firstChild + static_cast<uint32_t>(_child),
+						static_cast<uint32_t>(_childBegin - Pending.begin()),
+						static_cast<uint32_t>(_childEnd - Pending.begin()),
+						_task.Depth + 1 });
+				}
+				_childBegin = _childEnd;
 			}
 		}
+
+		Node& _node = Nodes[_task.Node];
+		_node.ItemBegin = static_cast<uint32_t>(ItemHandles.size());
+		_node.ItemCount = static_cast<uint32_t>(_stayEnd - _begin);
+		for (auto _item = _begin; _item != _stayEnd; ++_item) {
+			ItemHandles.push_back(_item->Handle);
+			ItemBounds.Push(_item->Bounds, _item->Layers);
+		}
 	}
+
+	Pending.clear();
+	Built = true;
 }
 
-void QuadTree::Query(const Rectf& _range, std::vector<Entity*>& _found) const
+void QuadTree::Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const
 {
-	if (!Bounds.Intersects(_range)) {
+	assert(Built && "QuadTree::Build must run after the last Insert");
+	if (Nodes.empty()) {
 		return;
 	}
 
-	for (auto* _entity : Items) {
-		if (_entity->GetBoundingRect().Intersects(_range)) {
-			_found.push_back(_entity);
-		}
-	}
+	// Depth-first: each level pops one node and pushes at most four.
+	std::array<uint32_t, 4 * MaxDepthLimit + 1> _stack;
+	size_t _top = 0;
+	_stack[_top++] = 0;
 
-	if (Children[0]) {
-		for (const auto& _child : Children) {
-			_child->Query(_range, _found);
+	while (_top > 0) {
+		const Node& _node = Nodes[_stack[--_top]];
+		if (!_node.Bounds.Intersects(_range)) {
+			continue;
 		}
-	}
-}
 
-bool QuadTree::InsertIntoChild(Entity* _entity)
-{
-	const Rectf _bounds = _entity->GetBoundingRect();
-	for (auto& _child : Children) {
-		if (_child && ContainsRect(_child->Bounds, _bounds)) {
-			_child->Insert(_entity);
-			return true;
+		AabbBatch::ForEachOverlap(_range, _layerMask, ItemBounds, _node.ItemBegin, _node.ItemCount, [this, &_found](size_t _item) {
+			_found.push_back(ItemHandles[_item]);
+		});
+
+		if (_node.FirstChild != 0) {
+			for (uint32_t _child = 0; _child < 4; ++_child) {
+				_stack[_top++] = _node.FirstChild + _child;
+			}
 		}
 	}
-	return false;
 }
 
-void QuadTree::Subdivide()
+uint32_t QuadTree::Subdivide(uint32_t _node)
 {
-	const float _halfWidth = Bounds.width / 2.0f;
-	const float _halfHeight = Bounds.height / 2.0f;
-	const float _x = Bounds.x;
-	const float _y = Bounds.y;
-
-	Children[0] = std::make_unique<QuadTree>(Rectf(_x, _y, _halfWidth, _halfHeight), Capacity, MaxDepth, Depth + 1);
-	Children[1] = std::make_unique<QuadTree>(Rectf(_x + _halfWidth, _y, _halfWidth, _halfHeight), Capacity, MaxDepth, Depth + 1);
-	Children[2] = std::make_unique<QuadTree>(Rectf(_x, _y + _halfHeight, _halfWidth, _halfHeight), Capacity, MaxDepth, Depth + 1);
-	Children[3] = std::make_unique<QuadTree>(Rectf(_x + _halfWidth, _y + _halfHeight, _halfWidth, _halfHeight), Capacity, MaxDepth, Depth + 1);
+	const Rectf _bounds = Nodes[_node].Bounds;
+	const float _halfWidth = _bounds.width / 2.0f;
+	const float _halfHeight = _bounds.height / 2.0f;
+	const float _x = _bounds.x;
+	const float _y = _bounds.y;
+
+	const uint32_t _first = static_cast<uint32_t>(Nodes.size());
+	Nodes[_node].FirstChild = _first;
+	Nodes.resize(Nodes.size() + 4);
+	Nodes[_first + 0].Bounds = Rectf(_x, _y, _halfWidth, _halfHeight);
+	Nodes[_first + 1].Bounds = Rectf(_x + _halfWidth, _y, _halfWidth, _halfHeight);
+	Nodes[_first + 2].Bounds = Rectf(_x, _y + _halfHeight, _halfWidth, _halfHeight);
+	Nodes[_first + 3].Bounds = Rectf(_x + _halfWidth, _y + _halfHeight, _halfWidth, _halfHeight);
+	return _first;
 }
 
-bool QuadTree::ContainsRect(const Rectf& _outer, const Rectf& _inner) const
+bool QuadTree::ContainsRect(const Rectf& _outer, const Rectf& _inner)
 {
 	return _inner.Left() >= _outer.Left()
 		&& _inner.Right() <= _outer.Right()
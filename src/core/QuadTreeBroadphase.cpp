@@ -0,0 +1,35 @@
+#include <core/QuadTreeBroadphase.h>
+
+QuadTreeBroadphase::QuadTreeBroadphase(const Rectf& _worldBounds, int _capacity, int _maxDepth)
+	: Tree(_worldBounds, _capacity, _maxDepth)
+{
+	//queryable while empty, e.g. before the first collision pass
+	Tree.Build();
+}
+
+void QuadTreeBroadphase::Update(const std::vector<BroadphaseProxy>& _proxies)
+{
+	Proxies = _proxies;
+	Tree.Clear();
+	for (const auto& _proxy : Proxies) {
+		Tree.Insert(_proxy.Handle, _proxy.Bounds, _proxy.Layers);
+	}
+	Tree.Build();
+}
+
+void QuadTreeBroadphase::Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const
+{
+	Tree.Query(_range, _layerMask, _found);
+}
+
+void QuadTreeBroadphase::FindPairsInRange(size_t _begin, size_t _end, std::vector<BroadphasePair>& _pairs) const
+{
+	FindPairsByQuery(Proxies, _begin, _end, _pairs);
+}
+
+void QuadTreeBroadphase::Clear()
+{
+	Tree.Clear();
+	Tree.Build();
+	Proxies.clear();
+}
@@ -14,25 +14,53 @@ ResourceHandler::~ResourceHandler()
 void ResourceHandler::Load(const std::string& _filename)
 {
 	// Check if already loaded
-	if (Resources.find(_filename) != Resources.end()) {
+	const StringId _id = StringId::Intern(_filename);
+	if (Resources.find(_id) != Resources.end()) {
 		return;
 	}
 
-	SDL_Texture* _texture = IMG_LoadTexture(Renderer, _filename.c_str());
+	//loaded as a surface first so the collision mask can be read from its pixels
+	SDL_Surface* _surface = IMG_Load(_filename.c_str());
+	if (!_surface) {
+		throw std::runtime_error("Could not load " + _filename + ": " + SDL_GetError());
+	}
+	SDL_Texture* _texture = SDL_CreateTextureFromSurface(Renderer, _surface);
 	if (!_texture) {
+		SDL_DestroySurface(_surface);
 		throw std::runtime_error("Could not load " + _filename + ": " + SDL_GetError());
 	}
 
-	Resources[_filename] = _texture;
+	Masks[_id] = PixelMask::FromSurface(_surface, MaskAlphaThreshold);
+	SDL_DestroySurface(_surface);
+	Resources[_id] = _texture;
+}
+
+SDL_Texture* ResourceHandler::Get(std::string_view _filename)
+{
+	return Get(StringId(_filename));
 }
 
-SDL_Texture* ResourceHandler::Get(const std::string& _filename)
+SDL_Texture* ResourceHandler::Get(StringId _filename)
 {
 	auto _found = Resources.find(_filename);
 	assert(_found != Resources.end());
 	return _found->second;
 }
 
+const PixelMask* ResourceHandler::GetMask(std::string_view _filename) const
+{
+	return GetMask(StringId(_filename));
+}
+
+const PixelMask* ResourceHandler::GetMask(StringId _filename) const
+{
+	auto _found = Masks.find(_filename);
+	if (_found == Masks.end() || _found->second.IsEmpty()) {
+		return nullptr;
+	}
+	return &_found->second;
+}
+
 void ResourceHandler::Flush()
 {
 	for (auto& _pair : Resources) {
@@ -41,4 +69,5 @@ void ResourceHandler::Flush()
 		}
 	}
 	Resources.clear();
+	Masks.clear();
 }
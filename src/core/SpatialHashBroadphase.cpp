@@ -0,0 +1,114 @@
+#include <core/SpatialHashBroadphase.h>
+#include <algorithm>
+#include <cmath>
+
+SpatialHashBroadphase::SpatialHashBroadphase(float _cellSize)
+	: CellSize(_cellSize > 0.0f ? _cellSize : 64.0f),
+	InverseCellSize(1.0f / CellSize)
+{
+}
+
+SpatialHashBroadphase::CellRange SpatialHashBroadphase::CellsOf(const Rectf& _bounds) const
+{
+	return {
+		static_cast<int32_t>(std::floor(_bounds.Left() * InverseCellSize)),
+		static_cast<int32_t>(std::floor(_bounds.Top() * InverseCellSize)),
+		static_cast<int32_t>(std::floor(_bounds.Right() * InverseCellSize)),
+		static_cast<int32_t>(std::floor(_bounds.Bottom() * InverseCellSize)),
+	};
+}
+
+uint32_t SpatialHashBroadphase::BucketOf(int32_t _cellX, int32_t _cellY) const
+{
+	const uint32_t _hash = static_cast<uint32_t>(_cellX) * 73856093u ^ static_cast<uint32_t>(_cellY) * 19349663u;
+	return _hash & BucketMask;
+}
+
+void SpatialHashBroadphase::Update(const std::vector<BroadphaseProxy>& _proxies)
+{
+	Proxies = _proxies;
+
+	size_t _entryCount = 0;
+	for (const auto& _proxy : Proxies) {
+		const CellRange _cells = CellsOf(_proxy.Bounds);
+		_entryCount += static_cast<size_t>(_cells.MaxX - _cells.MinX + 1) * static_cast<size_t>(_cells.MaxY - _cells.MinY + 1);
+	}
+
+	// About two buckets per entry keeps chains short.
+	uint32_t _bucketCount = 16;
+	while (_bucketCount < _entryCount * 2) {
+		_bucketCount <<= 1;
+	}
+	BucketMask = _bucketCount - 1;
+
+	// Counting sort of (cell, proxy) entries by bucket.
+	BucketStart.assign(_bucketCount + 1, 0);
+	for (const auto& _proxy : Proxies) {
+		const CellRange _cells = CellsOf(_proxy.Bounds);
+		for (int32_t _y = _cells.MinY; _y <= _cells.MaxY; ++_y) {
+			for (int32_t _x = _cells.MinX; _x <= _cells.MaxX; ++_x) {
+				++BucketStart[BucketOf(_x, _y) + 1];
+			}
+		}
+	}
+	for (uint32_t _bucket = 0; _bucket < _bucketCount; ++_bucket) {
+		BucketStart[_bucket + 1] += BucketStart[_bucket];
+	}
+
+	Entries.resize(_entryCount);
+	for (uint32_t _index = 0; _index < Proxies.size(); ++_index) {
+		const CellRange _cells = CellsOf(Proxies[_index].Bounds);
+		for (int32_t _y = _cells.MinY; _y <= _cells.MaxY; ++_y) {
+			for (int32_t _x = _cells.MinX; _x <= _cells.MaxX; ++_x) {
+				// BucketStart[b] doubles as the write cursor for bucket b while filling.
+				Entries[BucketStart[BucketOf(_x, _y)]++] = { _x, _y, _index };
+			}
+		}
+	}
+	// The cursors now sit at each bucket's end; shift them back into start offsets.
+	for (uint32_t _bucket = _bucketCount; _bucket > 0; --_bucket) {
+		BucketStart[_bucket] = BucketStart[_bucket - 1];
+	}
+	BucketStart[0] = 0;
+}
+
+void SpatialHashBroadphase::Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const
+{
+	if (Entries.empty()) {
+		return;
+	}
+	const CellRange _cells = CellsOf(_range);
+	for (int32_t _y = _cells.MinY; _y <= _cells.MaxY; ++_y) {
+		for (int32_t _x = _cells.MinX; _x <= _cells.MaxX; ++_x) {
+			const uint32_t _bucket = BucketOf(_x, _y);
+			for (uint32_t _index = BucketStart[_bucket]; _index < BucketStart[_bucket + 1]; ++_index) {
+				const CellEntry& _entry = Entries[_index];
+				if (_entry.CellX != _x || _entry.CellY != _y) {
+					continue;
+				}
+				const BroadphaseProxy& _proxy = Proxies[_entry.Proxy];
+				if ((_proxy.Layers & _layerMask) == 0 || !_proxy.Bounds.Intersects(_range)) {
+					continue;
+				}
+				// A proxy spanning several cells is reported only from the first cell it
+				// shares with the range.
+				const CellRange _proxyCells = CellsOf(_proxy.Bounds);
+				if (_x == std::max(_proxyCells.MinX, _cells.MinX) && _y == std::max(_proxyCells.MinY, _cells.MinY)) {
+					_found.push_back(_proxy.Handle);
+				}
+			}
+		}
+	}
+}
+
+void SpatialHashBroadphase::FindPairsInRange(size_t _begin, size_t _end, std::vector<BroadphasePair>& _pairs) const
+{
+	FindPairsByQuery(Proxies, _begin, _end, _pairs);
+}
+
+void SpatialHashBroadphase::Clear()
+{
+	Proxies.clear();
+	Entries.clear();
+	BucketStart.clear();
+}
@@ -7,6 +7,7 @@ Sprite::Sprite()
     , SrcRect(0, 0, 0, 0)
     , HasSrcRect(false)
     , FlipMode(SDL_FLIP_NONE)
+    , CollisionMask(nullptr)
 {
 }
 
@@ -51,6 +52,14 @@ void Sprite::SetFlipX(bool _flip)
     FlipMode = _flip ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
 }
 
+Recti Sprite::GetTextureRect() const
+{
+    if (HasSrcRect) {
+        return SrcRect;
+    }
+    return Recti(0, 0, static_cast<int>(DestRect.w), static_cast<int>(DestRect.h));
+}
+
 Rectf Sprite::GetGlobalBounds() const
 {
     return Rectf(DestRect.x, DestRect.y, DestRect.w, DestRect.h);
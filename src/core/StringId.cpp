@@ -0,0 +1,42 @@
+#include <core/StringId.h>
+#include <SDL3/SDL.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace {
+	// Prefabs may be parsed off the main thread, so the table is locked; interning only
+	// happens at load time, never in a steady-state frame.
+	struct InternTable
+	{
+		std::mutex								Lock;
+		std::unordered_map<uint64_t, std::string> Names;
+	};
+
+	InternTable& GetTable()
+	{
+		static InternTable _table;
+		return _table;
+	}
+}
+
+StringId StringId::Intern(std::string_view _name)
+{
+	const StringId _id(_name);
+	InternTable& _table = GetTable();
+	std::lock_guard<std::mutex> _guard(_table.Lock);
+	auto _result = _table.Names.try_emplace(_id.Value, _name);
+	if (!_result.second && _result.first->second != _name) {
+		SDL_Log("StringId: '%.*s' and '%s' hash to the same id.", static_cast<int>(_name.size()), _name.data(),
+			_result.first->second.c_str());
+	}
+	return _id;
+}
+
+std::string_view StringId::GetName() const
+{
+	InternTable& _table = GetTable();
+	std::lock_guard<std::mutex> _guard(_table.Lock);
+	auto _found = _table.Names.find(Value);
+	return _found != _table.Names.end() ? std::string_view(_found->second) : std::string_view();
+}
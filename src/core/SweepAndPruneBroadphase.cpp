@@ -0,0 +1,104 @@
+#include <core/SweepAndPruneBroadphase.h>
+#include <algorithm>
+
+SweepAndPruneBroadphase::Entry SweepAndPruneBroadphase::MakeEntry(const BroadphaseProxy& _proxy)
+{
+	return { _proxy.Bounds.Left(), _proxy.Bounds, _proxy.Handle, _proxy.Layers, _proxy.CollidesWith };
+}
+
+void SweepAndPruneBroadphase::Update(const std::vector<BroadphaseProxy>& _proxies)
+{
+	for (size_t _index = 0; _index < _proxies.size(); ++_index) {
+		const uint32_t _slot = _proxies[_index].Handle.Index;
+		if (_slot >= Lookup.size()) {
+			Lookup.resize(_slot + 1, 0);
+		}
+		Lookup[_slot] = static_cast<uint32_t>(_index + 1);
+	}
+
+	// Survivors keep last tick's order; new proxies go on the end.
+	Next.clear();
+	for (const auto& _entry : Entries) {
+		const uint32_t _slot = _entry.Handle.Index;
+		if (_slot >= Lookup.size() || Lookup[_slot] == 0) {
+			continue;
+		}
+		const BroadphaseProxy& _proxy = _proxies[Lookup[_slot] - 1];
+		if (_proxy.Handle != _entry.Handle) {
+			continue;
+		}
+		Next.push_back(MakeEntry(_proxy));
+		Lookup[_slot] = 0;
+	}
+	for (const auto& _proxy : _proxies) {
+		uint32_t& _lookup = Lookup[_proxy.Handle.Index];
+		if (_lookup != 0) {
+			Next.push_back(MakeEntry(_proxy));
+			_lookup = 0;
+		}
+	}
+	Entries.swap(Next);
+
+	// Insertion sort: O(n + swaps), and coherent motion needs few swaps.
+	MaxWidth = 0.0f;
+	for (size_t _index = 0; _index < Entries.size(); ++_index) {
+		MaxWidth = std::max(MaxWidth, Entries[_index].Bounds.width);
+		const Entry _entry = Entries[_index];
+		size_t _hole = _index;
+		while (_hole > 0 && Entries[_hole - 1].MinX > _entry.MinX) {
+			Entries[_hole] = Entries[_hole - 1];
+			--_hole;
+		}
+		Entries[_hole] = _entry;
+	}
+
+	Boxes.Clear();
+	for (const auto& _entry : Entries) {
+		Boxes.Push(_entry.Bounds, _entry.Layers);
+	}
+}
+
+void SweepAndPruneBroadphase::Query(const Rectf& _range, CollisionLayerMask _layerMask, std::vector<EntityHandle>& _found) const
+{
+	// Entries starting at or past the range's right edge are out, and so is anything starting
+	// further left than the widest entry could reach.
+	const auto _begin = std::lower_bound(Boxes.MinX.begin(), Boxes.MinX.end(), _range.Left() - MaxWidth);
+	const auto _end = std::lower_bound(_begin, Boxes.MinX.end(), _range.Right());
+	const size_t _first = static_cast<size_t>(_begin - Boxes.MinX.begin());
+	AabbBatch::ForEachOverlap(_range, _layerMask, Boxes, _first, static_cast<size_t>(_end - _begin), [this, &_found](size_t _entry) {
+		_found.push_back(Entries[_entry].Handle);
+	});
+}
+
+void SweepAndPruneBroadphase::FindPairsInRange(size_t _begin, size_t _end, std::vector<BroadphasePair>& _pairs) const
+{
+	const size_t _count = Entries.size();
+	const float* _minX = Boxes.MinX.data();
+	for (size_t _first = _begin; _first < _end; ++_first) {
+		const Entry& _a = Entries[_first];
+		if (_a.CollidesWith == 0) {
+			continue;
+		}
+		// The sweep run: everything after _a that starts before _a ends.
+		const float _maxX = _a.Bounds.Right();
+		size_t _runEnd = _first + 1;
+		while (_runEnd < _count && _minX[_runEnd] < _maxX) {
+			++_runEnd;
+		}
+		AabbBatch::ForEachOverlap(_a.Bounds, _a.CollidesWith, Boxes, _first + 1, _runEnd - _first - 1, [this, &_a, &_pairs](size_t _second) {
+			const EntityHandle _b = Entries[_second].Handle;
+			if (_a.Handle.Index < _b.Index) {
+				_pairs.push_back({ _a.Handle, _b });
+			} else {
+				_pairs.push_back({ _b, _a.Handle });
+			}
+		});
+	}
+}
+
+void SweepAndPruneBroadphase::Clear()
+{
+	Entries.clear();
+	Boxes.Clear();
+	MaxWidth = 0.0f;
+}
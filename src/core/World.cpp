@@ -1,16 +1,16 @@
 #include <core/World.h>
 #include <core/GameMode.h>
 #include <core/Camera.h>
+#include <core/engine/JobService.h>
 #include <core/engine/RenderService.h>
 #include <core/engine/RunnerService.h>
-#include <core/engine/ObjectPoolService.h>
 #include <algorithm>
 
 World::World(GameServiceHost& _services)
 	:Services(_services),
-	CameraTarget(nullptr),
 	Mode(nullptr),
-	UI(new UIManager(800.0f, 600.0f))
+	UI(new UIManager(800.0f, 600.0f)),
+	ActiveCount(0)
 {
 }
 
@@ -26,15 +26,41 @@ void World::SetGameMode(GameMode* _mode)
 
 void World::AddObject(std::unique_ptr<Entity> _entity)
 {
+	AssignHandle(*_entity);
 	AddQueue.push_back(std::move(_entity));
 }
 
+void World::DestroyObject(Entity& _entity)
+{
+	if (_entity.DestroyPending) {
+		return;
+	}
+	_entity.DestroyPending = true;
+	//nobody may hand it out again while it waits
+	_entity.SetReleaseListener(nullptr, 0);
+	_entity.Disable();
+	DestroyQueue.push_back(&_entity);
+}
+
 void World::ClearEntities()
 {
-	// Clear object pools first to prevent dangling pointers
-	Services.Get<ObjectPoolService>().ClearPools();
+	for (auto& _entity : Entities) {
+		ReleaseHandle(*_entity);
+	}
+	for (auto& _entity : AddQueue) {
+		ReleaseHandle(*_entity);
+	}
 	Entities.clear();
+	ActiveCount = 0;
 	AddQueue.clear();
+	PendingStateChanges.clear();
+	DestroyQueue.clear();
+	for (auto& _list : UpdateLists) {
+		_list.clear();
+	}
+	for (auto& _list : PostUpdateLists) {
+		_list.clear();
+	}
 }
 
 void World::Reset()
@@ -44,13 +70,14 @@ void World::Reset()
 	}
 }
 
-void World::UpdateCamera()
+void World::UpdateCamera(float _deltaTime, float _alpha)
 {
 	Camera* _camera = &Services.Get<RenderService>().GetCamera();
-	if (_camera && CameraTarget && CameraTarget->IsEnabled()) {
-		Vec2 _targetPos = CameraTarget->GetPosition();
+	Entity* _target = Resolve(CameraTarget);
+	if (_camera && _target && _target->IsEnabled()) {
+		Vec2 _targetPos = _target->GetInterpolatedPosition(_alpha);
 		_camera->SetTarget(_targetPos + Vec2(32, 32));
-		_camera->Update(Services.Get<RunnerService>().GetDeltaTime());
+		_camera->Update(_deltaTime);
 	}
 }
 
@@ -59,7 +86,7 @@ void World::SetBackgroundTexture(SDL_Texture* _texture)
 	Background.SetTexture(_texture);
 }
 
-void World::SetCameraTarget(Entity* _entity)
+void World::SetCameraTarget(EntityHandle _entity)
 {
 	CameraTarget = _entity;
 }
@@ -85,12 +112,14 @@ void World::Start()
 void World::Update()
 {
 	HandleQueue();
-	UpdateCamera();
-
-	for (auto& _entity : Entities) {
-		_entity->Update();
+	auto& _runner = Services.Get<RunnerService>();
+	// With fixed steps the camera follows at frame rate in Render instead.
+	if (!_runner.IsFixedTimestep()) {
+		UpdateCamera(_runner.GetDeltaTime(), 1.0f);
 	}
 
+	RunPhase(UpdateLists, &ComponentTypeInfo::UpdateBatch);
+
 	if (UI) {
 		UI->Update(Services.Get<RunnerService>().GetDeltaTime());
 	}
@@ -98,9 +127,9 @@ void World::Update()
 
 void World::PostUpdate()
 {
-	for (auto& _entity : Entities) {
-		_entity->PostUpdate();
-	}
+	ApplyStateChanges();
+	RunPhase(PostUpdateLists, &ComponentTypeInfo::PostUpdateBatch);
+	UpdateAnimators();
 }
 
 void World::Render()
@@ -109,10 +138,19 @@ void World::Render()
 	Camera* _camera = &renderService.GetCamera();
 	SDL_Renderer* renderer = renderService.GetRenderer();
 
+	ApplyStateChanges();
+
+	auto& _runner = Services.Get<RunnerService>();
+	float _alpha = 1.0f;
+	if (_runner.IsFixedTimestep()) {
+		_alpha = _runner.GetInterpolationAlpha();
+		UpdateCamera(_runner.GetFrameDeltaTime(), _alpha);
+	}
+
 	// Render world elements with camera transform
 	Background.Render(renderer, _camera);
-	for (auto& _entity : Entities) {
-		_entity->Render(renderer, _camera);
+	for (auto& _entity : GetActiveEntities()) {
+		_entity->Render(renderer, _camera, _alpha);
 	}
 
 	if (UI) {
@@ -120,10 +158,199 @@ void World::Render()
 	}
 }
 
+void World::SavePreviousPositions()
+{
+	for (auto& _entity : GetActiveEntities()) {
+		_entity->SnapInterpolation();
+	}
+}
+
 void World::HandleQueue()
 {
 	for (auto& _entity : AddQueue) {
+		Entity* _added = _entity.get();
+		_added->OwnerWorld = this;
+		_added->WorldSlot = Entities.size();
 		Entities.push_back(std::move(_entity));
+		if (_added->IsEnabled()) {
+			_added->SnapInterpolation();
+			SwapSlots(_added->WorldSlot, ActiveCount);
+			++ActiveCount;
+			LinkPhases(*_added);
+		}
 	}
 	AddQueue.clear();
+	ApplyStateChanges();
+	ApplyDestroys();
+}
+
+void World::NotifyStateChanged(Entity& _entity)
+{
+	if (!_entity.StateChangePending) {
+		_entity.StateChangePending = true;
+		PendingStateChanges.push_back(&_entity);
+	}
+}
+
+void World::ApplyStateChanges()
+{
+	for (Entity* _entity : PendingStateChanges) {
+		_entity->StateChangePending = false;
+		const size_t _slot = _entity->WorldSlot;
+		if (_entity->IsEnabled() && _slot >= ActiveCount) {
+			// Freshly activated (often pooled and moved): don't sweep from where it last was.
+			_entity->SnapInterpolation();
+			SwapSlots(_slot, ActiveCount);
+			++ActiveCount;
+			LinkPhases(*_entity);
+		} else if (!_entity->IsEnabled() && _slot < ActiveCount) {
+			--ActiveCount;
+			SwapSlots(_slot, ActiveCount);
+			UnlinkPhases(*_entity);
+		}
+	}
+	PendingStateChanges.clear();
+}
+
+void World::ApplyDestroys()
+{
+	for (Entity* _entity : DestroyQueue) {
+		size_t _slot = _entity->WorldSlot;
+		if (_slot < ActiveCount) {
+			//enabled again since it was queued
+			--ActiveCount;
+			SwapSlots(_slot, ActiveCount);
+			UnlinkPhases(*_entity);
+			_slot = ActiveCount;
+		}
+		//the tail is disabled too, so swapping it in keeps the partition
+		SwapSlots(_slot, Entities.size() - 1);
+		ReleaseHandle(*_entity);
+		Entities.pop_back();
+	}
+	DestroyQueue.clear();
+}
+
+void World::SwapSlots(size_t _a, size_t _b)
+{
+	if (_a == _b) {
+		return;
+	}
+	std::swap(Entities[_a], Entities[_b]);
+	Entities[_a]->WorldSlot = _a;
+	Entities[_b]->WorldSlot = _b;
+}
+
+void World::LinkPhases(Entity& _entity)
+{
+	for (auto& _component : _entity.Components) {
+		const ComponentTypeId _type = _component->TypeId;
+		const uint32_t _phases = ComponentType::GetInfo(_type).Phases;
+		if (_phases & ComponentPhaseUpdate) {
+			_component->UpdateSlot = static_cast<uint32_t>(UpdateLists[_type].size());
+			UpdateLists[_type].push_back(_component.get());
+		}
+		if (_phases & ComponentPhasePostUpdate) {
+			_component->PostUpdateSlot = static_cast<uint32_t>(PostUpdateLists[_type].size());
+			PostUpdateLists[_type].push_back(_component.get());
+		}
+	}
+}
+
+void World::UnlinkPhases(Entity& _entity)
+{
+	for (auto& _component : _entity.Components) {
+		const ComponentTypeId _type = _component->TypeId;
+		const uint32_t _phases = ComponentType::GetInfo(_type).Phases;
+		if (_phases & ComponentPhaseUpdate) {
+			auto& _list = UpdateLists[_type];
+			Component* _moved = _list.back();
+			_list[_component->UpdateSlot] = _moved;
+			_moved->UpdateSlot = _component->UpdateSlot;
+			_list.pop_back();
+		}
+		if (_phases & ComponentPhasePostUpdate) {
+			auto& _list = PostUpdateLists[_type];
+			Component* _moved = _list.back();
+			_list[_component->PostUpdateSlot] = _moved;
+			_moved->PostUpdateSlot = _component->PostUpdateSlot;
+			_list.pop_back();
+		}
+	}
+}
+
+void World::RunPhase(PhaseLists& _lists, ComponentBatchFn ComponentTypeInfo::* _batch)
+{
+	JobService* _jobs = Services.TryGet<JobService>();
+	for (ComponentTypeId _type = 0; _type < MaxComponentTypes; ++_type) {
+		auto& _list = _lists[_type];
+		if (_list.empty()) {
+			continue;
+		}
+		const ComponentTypeInfo& _info = ComponentType::GetInfo(_type);
+		const ComponentBatchFn _run = _info.*_batch;
+		if (_jobs && _info.ParallelUpdate) {
+			Component* const* _components = _list.data();
+			_jobs->ParallelFor(_list.size(), ParallelGrain, [_run, _components](size_t _begin, size_t _end) {
+				_run(_components + _begin, _end - _begin);
+			});
+		} else {
+			_run(_list.data(), _list.size());
+		}
+	}
+	//structural changes deferred by parallel batches land here, before anything else reads the world
+	if (_jobs) {
+		_jobs->FlushCommands();
+	}
+}
+
+void World::UpdateAnimators()
+{
+	//each animator only touches its own entity's sprite
+	const EntityRange _active = GetActiveEntities();
+	auto _run = [&_active](size_t _begin, size_t _end) {
+		for (size_t _index = _begin; _index < _end; ++_index) {
+			Entity& _entity = *_active.First[_index];
+			if (_entity.IsEnabled()) {
+				_entity.UpdateAnimator();
+			}
+		}
+	};
+	if (JobService* _jobs = Services.TryGet<JobService>()) {
+		_jobs->ParallelFor(_active.size(), ParallelGrain, _run);
+	} else {
+		_run(0, _active.size());
+	}
+}
+
+void World::AssignHandle(Entity& _entity)
+{
+	uint32_t _index;
+	if (!FreeHandles.empty()) {
+		_index = FreeHandles.back();
+		FreeHandles.pop_back();
+	} else {
+		_index = static_cast<uint32_t>(HandleSlots.size());
+		HandleSlots.emplace_back();
+	}
+	HandleSlots[_index].Target = &_entity;
+	_entity.Handle = { _index, HandleSlots[_index].Generation };
+}
+
+void World::ReleaseHandle(Entity& _entity)
+{
+	HandleSlot& _slot = HandleSlots[_entity.Handle.Index];
+	_slot.Target = nullptr;
+	++_slot.Generation;
+	FreeHandles.push_back(_entity.Handle.Index);
+	_entity.Handle = EntityHandle();
+}
+
+Entity* World::Resolve(EntityHandle _handle) const
+{
+	if (_handle.Index >= HandleSlots.size()) {
+		return nullptr;
+	}
+	const HandleSlot& _slot = HandleSlots[_handle.Index];
+	return _slot.Generation == _handle.Generation ? _slot.Target : nullptr;
 }
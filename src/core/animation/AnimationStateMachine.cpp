@@ -32,11 +32,16 @@ void AnimationStateMachine::Update(Sprite& _sprite)
 	}
 }
 
-void AnimationStateMachine::AddAnimation(const std::string& _name, AnimPtr _anim)
+void AnimationStateMachine::AddAnimation(StringId _name, AnimPtr _anim)
 {
 	AnimationMap.insert(std::make_pair(_name, std::move(_anim)));
 }
 
+void AnimationStateMachine::AddAnimation(std::string_view _name, AnimPtr _anim)
+{
+	AddAnimation(StringId::Intern(_name), std::move(_anim));
+}
+
 //is the next animation a priority animation?
 bool AnimationStateMachine::IsNextPriority()
 {
@@ -45,7 +50,12 @@ bool AnimationStateMachine::IsNextPriority()
 	return false;
 }
 
-void AnimationStateMachine::PlayAnimation(const std::string& _anim)
+void AnimationStateMachine::PlayAnimation(std::string_view _anim)
+{
+	PlayAnimation(StringId(_anim));
+}
+
+void AnimationStateMachine::PlayAnimation(StringId _anim)
 {
 	auto _found = AnimationMap.find(_anim);
 	assert(_found != AnimationMap.end());
@@ -3,6 +3,7 @@
 #include <core/ResourceHandler.h>
 #include <core/Camera.h>
 #include <core/engine/InputService.h>
+#include <core/engine/JobService.h>
 #include <core/engine/ObjectPoolService.h>
 #include <core/engine/PhysicsService.h>
 #include <core/engine/RenderService.h>
@@ -34,6 +35,7 @@ Engine::Engine()
 	}
 
 	Services.AddService<RunnerService>(ServiceOrder::Runner);
+	Services.AddService<JobService>(ServiceOrder::Jobs);
 	Services.AddService<TimerService>(ServiceOrder::Timer);
 	Services.AddService<InputService>(ServiceOrder::Input, InputManagerContext);
 	Services.AddService<PhysicsService>(ServiceOrder::Physics);
@@ -1,5 +1,12 @@
 #include <core/engine/GameServiceHost.h>
 #include <algorithm>
+#include <atomic>
+
+size_t ServiceType::NextId()
+{
+	static std::atomic<size_t> counter{ 0 };
+	return counter.fetch_add(1);
+}
 
 void GameServiceHost::Init()
 {
@@ -20,6 +27,13 @@ void GameServiceHost::Update()
 	}
 }
 
+void GameServiceHost::FixedUpdate()
+{
+	for (const auto& entry : Services) {
+		entry.Service->FixedUpdate();
+	}
+}
+
 void GameServiceHost::Shutdown()
 {
 	if (!Initialized) {
@@ -11,9 +11,20 @@ InputManager& InputService::GetInput() const
 	return Input;
 }
 
+void InputService::FixedUpdate()
+{
+	if (StepSawEdges) {
+		Input.BeginFrame();
+	}
+	StepSawEdges = true;
+}
+
 void InputService::BeginFrame()
 {
-	Input.BeginFrame();
+	if (StepSawEdges) {
+		Input.BeginFrame();
+		StepSawEdges = false;
+	}
 }
 
 void InputService::ProcessEvent(const SDL_Event& event)
@@ -0,0 +1,236 @@
+#include <core/engine/JobService.h>
+#include <cassert>
+
+namespace {
+	// Queue/command-buffer slot of the current thread; 0 for any thread outside the pool.
+	thread_local size_t CurrentSlot = 0;
+}
+
+JobService::JobService(size_t workerCount)
+	: RequestedWorkers(workerCount)
+{
+	if (RequestedWorkers == 0) {
+		const unsigned hardwareThreads = std::thread::hardware_concurrency();
+		RequestedWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+	Queues.push_back(std::make_unique<WorkQueue>());
+	CommandBuffers.resize(1);
+}
+
+JobService::~JobService()
+{
+	StopWorkers();
+}
+
+size_t JobService::GetCurrentThreadSlot()
+{
+	return CurrentSlot;
+}
+
+void JobService::Init()
+{
+	StartWorkers();
+}
+
+void JobService::Shutdown()
+{
+	StopWorkers();
+	FlushCommands();
+}
+
+void JobService::StartWorkers()
+{
+	if (!Workers.empty()) {
+		return;
+	}
+	Stopping = false;
+	for (size_t slot = 1; slot <= RequestedWorkers; ++slot) {
+		Queues.push_back(std::make_unique<WorkQueue>());
+	}
+	CommandBuffers.resize(RequestedWorkers + 1);
+	Workers.reserve(RequestedWorkers);
+	for (size_t slot = 1; slot <= RequestedWorkers; ++slot) {
+		Workers.emplace_back(&JobService::WorkerLoop, this, slot);
+	}
+}
+
+void JobService::StopWorkers()
+{
+	if (Workers.empty()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(SleepMutex);
+		Stopping = true;
+	}
+	SleepCondition.notify_all();
+	for (auto& worker : Workers) {
+		worker.join();
+	}
+	Workers.clear();
+	Queues.resize(1);
+}
+
+void JobService::Submit(JobGroup& group, Job job)
+{
+	group.Pending.fetch_add(1, std::memory_order_relaxed);
+	{
+		auto& queue = *Queues[CurrentSlot];
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		queue.Jobs.push_back({ std::move(job), &group });
+	}
+	{
+		// Taking the lock orders the increment against a worker checking it before sleeping.
+		std::lock_guard<std::mutex> lock(SleepMutex);
+		QueuedJobs.fetch_add(1, std::memory_order_release);
+	}
+	SleepCondition.notify_one();
+}
+
+void JobService::Wait(JobGroup& group)
+{
+	QueuedJob job;
+	while (!group.IsDone()) {
+		if (TryTake(CurrentSlot, job)) {
+			Execute(job);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobService::WorkerLoop(size_t slot)
+{
+	CurrentSlot = slot;
+	QueuedJob job;
+	for (;;) {
+		if (TryTake(slot, job)) {
+			Execute(job);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(SleepMutex);
+		SleepCondition.wait(lock, [this]() {
+			return Stopping || QueuedJobs.load(std::memory_order_acquire) > 0;
+		});
+		if (Stopping && QueuedJobs.load(std::memory_order_acquire) == 0) {
+			return;
+		}
+	}
+}
+
+bool JobService::TryTake(size_t slot, QueuedJob& out)
+{
+	if (QueuedJobs.load(std::memory_order_acquire) == 0) {
+		return false;
+	}
+
+	{
+		auto& own = *Queues[slot];
+		std::lock_guard<std::mutex> lock(own.Mutex);
+		if (!own.Jobs.empty()) {
+			out = std::move(own.Jobs.back());
+			own.Jobs.pop_back();
+			QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	const size_t queueCount = Queues.size();
+	for (size_t offset = 1; offset < queueCount; ++offset) {
+		auto& victim = *Queues[(slot + offset) % queueCount];
+		std::lock_guard<std::mutex> lock(victim.Mutex);
+		if (!victim.Jobs.empty()) {
+			out = std::move(victim.Jobs.front());
+			victim.Jobs.pop_front();
+			QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobService::Execute(QueuedJob& job)
+{
+	job.Work();
+	job.Work = nullptr;
+	job.Group->Pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobService::Run(JobGraph& graph)
+{
+	const size_t taskCount = graph.Tasks.size();
+	if (taskCount == 0) {
+		return;
+	}
+
+	std::unique_ptr<std::atomic<size_t>[]> remaining(new std::atomic<size_t>[taskCount]);
+	for (size_t id = 0; id < taskCount; ++id) {
+		remaining[id].store(graph.Tasks[id].DependencyCount, std::memory_order_relaxed);
+	}
+
+	// A finishing task submits its ready successors before its own completion is counted,
+	// so the group cannot drain while work is still reachable.
+	JobGroup group;
+	std::function<void(JobGraph::TaskId)> schedule = [&](JobGraph::TaskId id) {
+		Submit(group, [&, id]() {
+			auto& task = graph.Tasks[id];
+			if (task.Work) {
+				task.Work();
+			}
+			for (const auto successor : task.Successors) {
+				if (remaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					schedule(successor);
+				}
+			}
+		});
+	};
+
+	for (size_t id = 0; id < taskCount; ++id) {
+		if (graph.Tasks[id].DependencyCount == 0) {
+			schedule(id);
+		}
+	}
+	Wait(group);
+}
+
+void JobService::Defer(Job command)
+{
+	CommandBuffers[CurrentSlot].push_back(std::move(command));
+}
+
+void JobService::FlushCommands()
+{
+	assert(CurrentSlot == 0 && "Commands are flushed from the owning thread at a sync point");
+	// Replayed commands may defer more work; keep going until every buffer is empty.
+	std::vector<Job> replay;
+	bool flushed = true;
+	while (flushed) {
+		flushed = false;
+		for (auto& buffer : CommandBuffers) {
+			if (buffer.empty()) {
+				continue;
+			}
+			replay.swap(buffer);
+			for (auto& command : replay) {
+				command();
+			}
+			replay.clear();
+			flushed = true;
+		}
+	}
+}
+
+JobGraph::TaskId JobGraph::AddTask(JobService::Job work)
+{
+	Task task;
+	task.Work = std::move(work);
+	Tasks.push_back(std::move(task));
+	return Tasks.size() - 1;
+}
+
+void JobGraph::AddDependency(TaskId before, TaskId after)
+{
+	assert(before < Tasks.size() && after < Tasks.size() && before != after);
+	Tasks[before].Successors.push_back(after);
+	++Tasks[after].DependencyCount;
+}
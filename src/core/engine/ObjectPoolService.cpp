@@ -1,9 +1,13 @@
 #include <core/engine/ObjectPoolService.h>
 #include <core/PrefabSystem.h>
 #include <core/Entity.h>
+#include <core/World.h>
 #include <core/engine/RunnerService.h>
 #include <core/engine/WorldService.h>
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 ObjectPoolService::ObjectPoolService(PrefabSystem& prefabs)
 	:Prefabs(prefabs)
@@ -17,23 +21,29 @@ void ObjectPoolService::Init()
 void ObjectPoolService::Update()
 {
 	const float currentTime = GetHost().Get<RunnerService>().GetElapsedTime();
+	auto& world = GetHost().Get<WorldService>().GetWorld();
 	for (auto it = Pools.begin(); it != Pools.end(); ) {
 		auto& pool = it->second;
-		if (pool.NextMaintenanceTime <= 0.0f) {
+		if (pool.Draining) {
+			// Entries destroyed as they came back resolve to nothing now; the pool goes once all have.
+			CompactPool(pool, world, 0);
+		} else if (pool.NextMaintenanceTime <= 0.0f) {
 			pool.NextMaintenanceTime = currentTime + MaintenanceIntervalSeconds;
 		}
-		while (currentTime >= pool.NextMaintenanceTime) {
+		while (!pool.Draining && currentTime >= pool.NextMaintenanceTime) {
 			if (RunMaintenance(pool)) {
 				break;
 			}
 			pool.NextMaintenanceTime += MaintenanceIntervalSeconds;
 		}
-		if (pool.Size == 0) {
+		if (pool.Size() == 0 && pool.PendingGrowth == 0) {
 			it = Pools.erase(it);
 		} else {
 			++it;
 		}
 	}
+	UpdateGrowth();
+	UpdateMemoryStats();
 }
 
 void ObjectPoolService::Shutdown()
@@ -42,8 +52,15 @@ void ObjectPoolService::Shutdown()
 }
 
 Entity* ObjectPoolService::FetchPrefab(std::string_view prefabId)
+{
+	return FetchPrefab(StringId::Intern(prefabId));
+}
+
+Entity* ObjectPoolService::FetchPrefab(StringId prefabId)
 {
 	auto& pool = GetOrCreatePool(prefabId);
+	// Demand is back: entities still out are pooled again instead of destroyed.
+	pool.Draining = false;
 	auto* entity = AcquireFromPool(pool);
 	if (!entity) {
 		return nullptr;
@@ -54,105 +71,328 @@ Entity* ObjectPoolService::FetchPrefab(std::string_view prefabId)
 	return entity;
 }
 
+void ObjectPoolService::PrewarmPools()
+{
+	for (const auto* definition : Prefabs.GetDefinitions()) {
+		if (definition->Pool.Declared) {
+			auto& pool = GetOrCreatePool(StringId(definition->Id));
+			EnsurePoolSize(pool, pool.InitialSize);
+		}
+	}
+}
+
 void ObjectPoolService::ClearPools()
 {
+	const auto& world = GetHost().Get<WorldService>().GetWorld();
+	for (auto& entry : Pools) {
+		DetachPool(entry.second, world);
+	}
 	Pools.clear();
+	UpdateMemoryStats();
+}
+
+std::vector<PoolStats> ObjectPoolService::GetPoolStats() const
+{
+	std::vector<PoolStats> stats;
+	stats.reserve(Pools.size());
+	for (const auto& entry : Pools) {
+		const auto& pool = entry.second;
+		stats.push_back({ pool.PrefabId, pool.Size(), pool.GetActiveCount(), pool.PendingGrowth, pool.GetBytes(), pool.PeakBytes });
+	}
+	return stats;
+}
+
+size_t ObjectPoolService::Pool::GetBytes() const
+{
+	return Size() * EntityFootprint
+		+ Entries.capacity() * sizeof(EntityHandle)
+		+ FreeSlots.capacity() * sizeof(uint32_t)
+		+ SlotFree.capacity() * sizeof(uint8_t);
 }
 
-ObjectPoolService::Pool& ObjectPoolService::GetOrCreatePool(std::string_view prefabId)
+void ObjectPoolService::UpdateMemoryStats()
 {
-	auto key = std::string(prefabId);
-	auto iter = Pools.find(key);
+	CurrentBytes = 0;
+	for (auto& entry : Pools) {
+		auto& pool = entry.second;
+		const size_t bytes = pool.GetBytes();
+		pool.PeakBytes = std::max(pool.PeakBytes, bytes);
+		CurrentBytes += bytes;
+	}
+	PeakBytes = std::max(PeakBytes, CurrentBytes);
+}
+
+ObjectPoolService::Pool& ObjectPoolService::GetOrCreatePool(StringId prefabId)
+{
+	auto iter = Pools.find(prefabId);
 	if (iter != Pools.end()) {
 		return iter->second;
 	}
 
-	Pool pool;
-	pool.PrefabId = key;
+	// Built in place: its entities keep a pointer to it.
+	Pool& pool = Pools.try_emplace(prefabId).first->second;
+	pool.Id = prefabId;
+	// Prefab names are interned when loaded; the text is only kept for logs and stats.
+	pool.PrefabId = std::string(prefabId.GetName());
 	pool.NextMaintenanceTime = GetHost().Get<RunnerService>().GetElapsedTime() + MaintenanceIntervalSeconds;
-	EnsurePoolSize(pool, DefaultPoolSize);
-	auto inserted = Pools.emplace(key, std::move(pool));
-	return inserted.first->second;
+	if (const auto* definition = Prefabs.Find(prefabId); definition && definition->Pool.Declared) {
+		pool.Declared = true;
+		pool.InitialSize = definition->Pool.Initial;
+		pool.MaxSize = definition->Pool.Max;
+		pool.Growth = definition->Pool.Growth;
+	}
+	EnsurePoolSize(pool, pool.InitialSize);
+	return pool;
 }
 
 Entity* ObjectPoolService::AcquireFromPool(Pool& pool)
 {
-	for (auto* entity : pool.Entries) {
-		if (entity && !entity->IsEnabled()) {
-			return entity;
+	const auto& world = GetHost().Get<WorldService>().GetWorld();
+	++pool.FrameAcquisitions;
+	Entity* entity = PopFreeEntry(pool, world);
+	if (!entity) {
+		// Dry: only the emergency reserve is built now; the growth step is queued behind it.
+		const size_t growthTarget = GetGrowthTarget(pool);
+		const size_t emergencySize = pool.Size() + std::max<size_t>(GrowthSettings.EmergencyReserve, 1);
+		if (pool.MaxSize != 0 && emergencySize > pool.MaxSize && !pool.ReportedOverMax) {
+			// Past the declared max the pool still grows, so a bad estimate shows up in the
+			// log instead of as missing entities.
+			SDL_Log("ObjectPoolService: Pool '%s' exceeded its declared max of %zu.", pool.PrefabId.c_str(), pool.MaxSize);
+			pool.ReportedOverMax = true;
+		}
+		// The reserve counts against growth that was already queued.
+		const size_t reserve = emergencySize - pool.Size();
+		pool.PendingGrowth -= std::min(pool.PendingGrowth, reserve);
+		EnsurePoolSize(pool, emergencySize);
+		ScheduleGrowth(pool, growthTarget);
+		entity = PopFreeEntry(pool, world);
+	}
+	const size_t headroom = GetHeadroom(pool);
+	if (pool.FreeSlots.size() < headroom) {
+		ScheduleGrowth(pool, pool.Size() + headroom - pool.FreeSlots.size());
+	}
+	return entity;
+}
+
+size_t ObjectPoolService::GetHeadroom(const Pool& pool) const
+{
+	return GrowthSettings.EmergencyReserve
+		+ static_cast<size_t>(std::ceil(pool.AcquisitionRate * GrowthSettings.LookaheadSeconds));
+}
+
+size_t ObjectPoolService::GetGrowthTarget(const Pool& pool) const
+{
+	const size_t grown = static_cast<size_t>(std::ceil(static_cast<float>(pool.Size()) * pool.Growth));
+	const size_t target = std::max({ grown, pool.Size() + 1, pool.InitialSize });
+	return pool.MaxSize != 0 ? std::min(target, pool.MaxSize) : target;
+}
+
+void ObjectPoolService::ScheduleGrowth(Pool& pool, size_t targetSize)
+{
+	if (pool.MaxSize != 0) {
+		targetSize = std::min(targetSize, pool.MaxSize);
+	}
+	if (targetSize > pool.Size() + pool.PendingGrowth) {
+		pool.PendingGrowth = targetSize - pool.Size();
+	}
+}
+
+void ObjectPoolService::UpdateGrowth()
+{
+	const float frameTime = GetHost().Get<RunnerService>().GetFrameDeltaTime();
+	for (auto& entry : Pools) {
+		auto& pool = entry.second;
+		if (frameTime > 0.0f) {
+			const float rate = static_cast<float>(pool.FrameAcquisitions) / frameTime;
+			pool.AcquisitionRate += (rate - pool.AcquisitionRate) * GrowthSettings.RateSmoothing;
+		}
+		pool.FrameAcquisitions = 0;
+		if (pool.Draining) {
+			continue;
+		}
+		const size_t headroom = GetHeadroom(pool);
+		if (pool.FreeSlots.size() < headroom) {
+			ScheduleGrowth(pool, pool.Size() + headroom - pool.FreeSlots.size());
 		}
 	}
 
-	const size_t targetSize = (pool.Size == 0) ? DefaultPoolSize : pool.Size * 2;
-	EnsurePoolSize(pool, targetSize);
+	// One entity per pool per round, so a busy pool can't starve the others.
+	using Clock = std::chrono::steady_clock;
+	const auto start = Clock::now();
+	const auto timeBudget = std::chrono::duration<float, std::micro>(GrowthSettings.MicrosecondsPerFrame);
+	size_t budget = GrowthSettings.EntitiesPerFrame;
+	bool progressed = true;
+	while (budget > 0 && progressed) {
+		progressed = false;
+		for (auto& entry : Pools) {
+			auto& pool = entry.second;
+			if (pool.PendingGrowth == 0) {
+				continue;
+			}
+			if (!Prefabs.Find(pool.Id)) {
+				pool.PendingGrowth = 0;
+				continue;
+			}
+			EnsurePoolSize(pool, pool.Size() + 1);
+			--pool.PendingGrowth;
+			--budget;
+			progressed = true;
+			if (budget == 0 || Clock::now() - start >= timeBudget) {
+				return;
+			}
+		}
+	}
+}
 
-	for (auto* entity : pool.Entries) {
+Entity* ObjectPoolService::PopFreeEntry(Pool& pool, const World& world)
+{
+	while (!pool.FreeSlots.empty()) {
+		const uint32_t slot = pool.FreeSlots.back();
+		pool.FreeSlots.pop_back();
+		pool.SlotFree[slot] = 0;
+		auto* entity = world.Resolve(pool.Entries[slot]);
+		// A destroyed entry is dropped at the next maintenance; an enabled one is released
+		// again, and so re-listed, when it is next disabled.
 		if (entity && !entity->IsEnabled()) {
 			return entity;
 		}
 	}
-
 	return nullptr;
 }
 
+void ObjectPoolService::Pool::OnEntityReleased(Entity& entity, uint32_t ticket)
+{
+	if (ticket < Entries.size() && SlotFree[ticket] == 0 && Entries[ticket] == entity.GetHandle()) {
+		if (Draining) {
+			Entries[ticket] = EntityHandle();
+			DrainWorld->DestroyObject(entity);
+			return;
+		}
+		SlotFree[ticket] = 1;
+		FreeSlots.push_back(ticket);
+	}
+}
+
 void ObjectPoolService::EnsurePoolSize(Pool& pool, size_t newSize)
 {
-	if (newSize <= pool.Size) {
+	if (newSize <= pool.Size()) {
 		return;
 	}
 
-	const auto* definition = Prefabs.Find(pool.PrefabId);
+	const auto* definition = Prefabs.Find(pool.Id);
 	if (!definition) {
 		SDL_Log("ObjectPoolService: Prefab '%s' not found.", pool.PrefabId.c_str());
 		return;
 	}
 
 	auto& world = GetHost().Get<WorldService>().GetWorld();
-	const size_t toCreate = newSize - pool.Size;
+	const size_t toCreate = newSize - pool.Size();
 	for (size_t index = 0; index < toCreate; ++index) {
 		auto entity = Prefabs.Instantiate(*definition);
 		if (!entity) {
 			continue;
 		}
 		entity->Disable();
-		pool.Entries.push_back(entity.get());
+		pool.EntityFootprint = std::max(pool.EntityFootprint, entity->GetMemoryFootprint());
+		const uint32_t slot = static_cast<uint32_t>(pool.Entries.size());
+		entity->SetReleaseListener(&pool, slot);
+		Entity* added = entity.get();
 		world.AddObject(std::move(entity));
-		pool.Size += 1;
+		pool.Entries.push_back(added->GetHandle());
+		pool.SlotFree.push_back(1);
+		pool.FreeSlots.push_back(slot);
 	}
+	// Growth is where the peak is reached, so it is sampled here as well as once a frame.
+	UpdateMemoryStats();
 }
 
 bool ObjectPoolService::RunMaintenance(Pool& pool)
 {
-	if (pool.Size == 0) {
+	if (pool.Size() == 0) {
 		return true;
 	}
 
-	size_t activeCount = 0;
-	for (auto* entity : pool.Entries) {
-		if (entity && entity->IsEnabled()) {
-			++activeCount;
-		}
+	auto& world = GetHost().Get<WorldService>().GetWorld();
+	CompactPool(pool, world, 0);
+
+	const float halfSize = static_cast<float>(pool.Size()) * 0.5f;
+	if (pool.GetActiveCount() >= halfSize || pool.PendingGrowth > 0) {
+		return false;
 	}
 
-	const float halfSize = static_cast<float>(pool.Size) * 0.5f;
-	if (activeCount >= halfSize) {
+	// Never trim into the headroom growth would only have to rebuild.
+	const size_t keepSize = pool.GetActiveCount() + GetHeadroom(pool);
+
+	// Declared pools never shrink below what they were prewarmed to.
+	if (pool.Declared) {
+		const size_t targetSize = std::max({ pool.Size() / 2, pool.InitialSize, keepSize });
+		if (targetSize < pool.Size()) {
+			CompactPool(pool, world, pool.Size() - targetSize);
+		}
 		return false;
 	}
 
-	if (pool.Size <= DefaultPoolSize) {
-		pool.Entries.clear();
-		pool.Size = 0;
+	if (pool.Size() <= DefaultPoolSize && pool.AcquisitionRate * GrowthSettings.LookaheadSeconds < 1.0f) {
+		CompactPool(pool, world, pool.FreeSlots.size());
+		if (pool.GetActiveCount() > 0) {
+			// Entities still out stay attached and are destroyed as they come back, rather than
+			// being left in the world with nobody to reuse or free them.
+			pool.Draining = true;
+			pool.DrainWorld = &world;
+			pool.PendingGrowth = 0;
+		}
 		return true;
 	}
 
-	const size_t targetSize = pool.Size / 2;
-	for (auto it = pool.Entries.begin(); it != pool.Entries.end() && pool.Size > targetSize; ) {
-		if (*it && !(*it)->IsEnabled()) {
-			it = pool.Entries.erase(it);
-			--pool.Size;
-		} else {
-			++it;
-		}
+	const size_t targetSize = std::max(pool.Size() / 2, keepSize);
+	if (targetSize < pool.Size()) {
+		CompactPool(pool, world, pool.Size() - targetSize);
 	}
 	return false;
 }
+
+void ObjectPoolService::CompactPool(Pool& pool, World& world, size_t freeToDrop)
+{
+	size_t kept = 0;
+	for (size_t index = 0; index < pool.Entries.size(); ++index) {
+		auto* entity = world.Resolve(pool.Entries[index]);
+		if (!entity) {
+			continue;
+		}
+		if (pool.SlotFree[index] != 0 && freeToDrop > 0) {
+			world.DestroyObject(*entity);
+			--freeToDrop;
+			continue;
+		}
+		entity->SetReleaseListener(&pool, static_cast<uint32_t>(kept));
+		pool.Entries[kept] = pool.Entries[index];
+		pool.SlotFree[kept] = pool.SlotFree[index];
+		++kept;
+	}
+	pool.Entries.resize(kept);
+	pool.SlotFree.resize(kept);
+	pool.FreeSlots.clear();
+	// Give back bookkeeping left over from a burst, too.
+	if (pool.Entries.capacity() > kept * 2) {
+		pool.Entries.shrink_to_fit();
+		pool.SlotFree.shrink_to_fit();
+		pool.FreeSlots.shrink_to_fit();
+	}
+	for (size_t index = 0; index < kept; ++index) {
+		if (pool.SlotFree[index] != 0) {
+			pool.FreeSlots.push_back(static_cast<uint32_t>(index));
+		}
+	}
+}
+
+void ObjectPoolService::DetachPool(Pool& pool, const World& world)
+{
+	for (const auto handle : pool.Entries) {
+		if (auto* entity = world.Resolve(handle)) {
+			entity->SetReleaseListener(nullptr, 0);
+		}
+	}
+	pool.Entries.clear();
+	pool.SlotFree.clear();
+	pool.FreeSlots.clear();
+}
@@ -1,6 +1,170 @@
 #include <core/engine/PhysicsService.h>
+#include <core/PixelMask.h>
 #include <core/World.h>
+#include <core/engine/JobService.h>
 #include <core/engine/WorldService.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RG_PHYSICS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+	// Scratch for queries that filter broadphase candidates; per thread so parallel
+	// component updates and the pair search can query at the same time.
+	thread_local std::vector<EntityHandle> QueryCandidates;
+
+	Rectf Offset(const Rectf& rect, const Vec2& offset)
+	{
+		return Rectf(rect.x + offset.x, rect.y + offset.y, rect.width, rect.height);
+	}
+
+	// Everything `start` covers while moving by `motion`.
+	Rectf SweptBounds(const Rectf& start, const Vec2& motion)
+	{
+		return Rectf(start.x + std::min(motion.x, 0.0f), start.y + std::min(motion.y, 0.0f),
+			start.width + std::fabs(motion.x), start.height + std::fabs(motion.y));
+	}
+
+	// Earliest fraction of `motion` at which `start` overlaps the stationary `target`, with
+	// the same strict test as Rect::Intersects. 0 when they already overlap.
+	bool SweepRects(const Rectf& start, const Vec2& motion, const Rectf& target, float& timeOfImpact)
+	{
+		float enter = 0.0f;
+		float exit = 1.0f;
+		const float moves[2] = { motion.x, motion.y };
+		const float mins[2] = { start.Left(), start.Top() };
+		const float maxs[2] = { start.Right(), start.Bottom() };
+		const float targetMins[2] = { target.Left(), target.Top() };
+		const float targetMaxs[2] = { target.Right(), target.Bottom() };
+		for (int axis = 0; axis < 2; ++axis) {
+			if (moves[axis] == 0.0f) {
+				if (maxs[axis] <= targetMins[axis] || mins[axis] >= targetMaxs[axis]) {
+					return false;
+				}
+				continue;
+			}
+			const float inverse = 1.0f / moves[axis];
+			float near = (targetMins[axis] - maxs[axis]) * inverse;
+			float far = (targetMaxs[axis] - mins[axis]) * inverse;
+			if (near > far) {
+				std::swap(near, far);
+			}
+			enter = std::max(enter, near);
+			exit = std::min(exit, far);
+			if (enter >= exit) {
+				return false;
+			}
+		}
+		timeOfImpact = enter;
+		return true;
+	}
+
+	struct IntegrationParams
+	{
+		float DeltaTime;
+		float GravityY;
+		float TerminalVelocity;
+		float MinX;
+		float MaxX;
+		float GroundLevel;
+	};
+
+	// Scalar reference for one body; the SIMD path below must produce identical results.
+	void IntegrateBody(const IntegrationParams& params, size_t i, float* posX, float* posY,
+		float* velX, float* velY, float* accX, float* accY, const float* gravityScale, const float* width)
+	{
+		float vx = velX[i] + accX[i] * params.DeltaTime;
+		float vy = velY[i] + accY[i] * params.DeltaTime;
+		accX[i] = 0.0f;
+		accY[i] = 0.0f;
+
+		const float gravityAccel = params.GravityY * gravityScale[i];
+		if (gravityAccel > 0.0f && vy < params.TerminalVelocity) {
+			vy = std::min(vy + gravityAccel * params.DeltaTime, params.TerminalVelocity);
+		}
+		velX[i] = vx;
+		velY[i] = vy;
+
+		float x = posX[i] + vx * params.DeltaTime;
+		float y = posY[i] + vy * params.DeltaTime;
+		x = std::max(x, params.MinX);
+		x = std::min(x, params.MaxX - width[i]);
+		y = std::min(y, params.GroundLevel);
+		posX[i] = x;
+		posY[i] = y;
+	}
+
+#if RG_PHYSICS_SSE2
+	inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+#endif
+
+	void IntegrateBodies(const IntegrationParams& params, size_t count,
+		float* posX, float* posY, float* velX, float* velY, float* accX, float* accY,
+		const float* gravityScale, const float* width)
+	{
+		size_t i = 0;
+#if RG_PHYSICS_SSE2
+		const __m128 dt = _mm_set1_ps(params.DeltaTime);
+		const __m128 gravity = _mm_set1_ps(params.GravityY);
+		const __m128 terminal = _mm_set1_ps(params.TerminalVelocity);
+		const __m128 minX = _mm_set1_ps(params.MinX);
+		const __m128 maxX = _mm_set1_ps(params.MaxX);
+		const __m128 ground = _mm_set1_ps(params.GroundLevel);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (; i + 4 <= count; i += 4) {
+			const __m128 vx = _mm_add_ps(_mm_loadu_ps(velX + i), _mm_mul_ps(_mm_loadu_ps(accX + i), dt));
+			__m128 vy = _mm_add_ps(_mm_loadu_ps(velY + i), _mm_mul_ps(_mm_loadu_ps(accY + i), dt));
+
+			const __m128 gravityAccel = _mm_mul_ps(gravity, _mm_loadu_ps(gravityScale + i));
+			const __m128 applyGravity = _mm_and_ps(_mm_cmpgt_ps(gravityAccel, zero), _mm_cmplt_ps(vy, terminal));
+			const __m128 fallen = _mm_min_ps(_mm_add_ps(vy, _mm_mul_ps(gravityAccel, dt)), terminal);
+			vy = Select(applyGravity, fallen, vy);
+
+			__m128 x = _mm_add_ps(_mm_loadu_ps(posX + i), _mm_mul_ps(vx, dt));
+			__m128 y = _mm_add_ps(_mm_loadu_ps(posY + i), _mm_mul_ps(vy, dt));
+			x = _mm_max_ps(x, minX);
+			x = _mm_min_ps(x, _mm_sub_ps(maxX, _mm_loadu_ps(width + i)));
+			y = _mm_min_ps(y, ground);
+
+			_mm_storeu_ps(velX + i, vx);
+			_mm_storeu_ps(velY + i, vy);
+			_mm_storeu_ps(accX + i, zero);
+			_mm_storeu_ps(accY + i, zero);
+			_mm_storeu_ps(posX + i, x);
+			_mm_storeu_ps(posY + i, y);
+		}
+#endif
+		for (; i < count; ++i) {
+			IntegrateBody(params, i, posX, posY, velX, velY, accX, accY, gravityScale, width);
+		}
+	}
+}
+
+CollisionMatrix DefaultCollisionMatrix()
+{
+	CollisionMatrix matrix{};
+	auto allow = [&matrix](ENTITY_TAG a, ENTITY_TAG b) {
+		matrix[a] |= LayerOf(b);
+		matrix[b] |= LayerOf(a);
+	};
+	allow(player, hazard);
+	allow(player, enemy_bullet);
+	allow(player, pickup);
+	allow(bullet, hazard);
+	allow(bullet, pickup);
+	allow(enemy_bullet, pickup);
+	return matrix;
+}
 
 PhysicsService::PhysicsService()
 	: PhysicsService(PhysicsConfig{})
@@ -12,52 +176,778 @@ PhysicsService::PhysicsService(const PhysicsConfig& config)
 	TerminalVelocity(config.TerminalVelocity),
 	GroundLevel(config.GroundLevel),
 	WorldBounds(config.WorldBounds),
-	CollisionTree(config.WorldBounds)
+	LayerMatrix(config.LayerMatrix),
+	BroadphaseSettings(config.Broadphase),
+	SleepTicks(config.SleepTicks),
+	PixelCollision(config.PixelCollision),
+	Broadphase(CreateBroadphase(config.Broadphase, config.WorldBounds)),
+	RestingBroadphase(CreateBroadphase(config.Broadphase, config.WorldBounds))
 {
 }
 
 void PhysicsService::SetWorldBounds(const Rectf& bounds)
 {
 	WorldBounds = bounds;
-	CollisionTree = QuadTree(bounds);
+	Broadphase = CreateBroadphase(BroadphaseSettings, WorldBounds);
+	RestingBroadphase = CreateBroadphase(BroadphaseSettings, WorldBounds);
+	RestingBroadphaseStale = true;
+}
+
+void PhysicsService::SetBroadphase(const BroadphaseConfig& config)
+{
+	BroadphaseSettings = config;
+	Broadphase = CreateBroadphase(BroadphaseSettings, WorldBounds);
+	RestingBroadphase = CreateBroadphase(BroadphaseSettings, WorldBounds);
+	RestingBroadphaseStale = true;
+}
+
+void PhysicsService::SetLayersCollide(ENTITY_TAG a, ENTITY_TAG b, bool collide)
+{
+	if (collide) {
+		LayerMatrix[a] |= LayerOf(b);
+		LayerMatrix[b] |= LayerOf(a);
+	} else {
+		LayerMatrix[a] &= ~LayerOf(b);
+		LayerMatrix[b] &= ~LayerOf(a);
+	}
+}
+
+CollisionLayerMask PhysicsService::GetCollisionMask(CollisionLayerMask layers) const
+{
+	CollisionLayerMask mask = 0;
+	for (size_t layer = 0; layers != 0; ++layer, layers >>= 1) {
+		if (layers & 1u) {
+			mask |= LayerMatrix[layer];
+		}
+	}
+	return mask;
 }
 
-void PhysicsService::Update()
+void PhysicsService::FixedUpdate()
 {
 	auto& world = GetHost().Get<WorldService>().GetWorld();
-	const auto& entities = world.GetEntities();
-	if (entities.empty()) {
+	const EntityRange entities = world.GetActiveEntities();
+	if (entities.empty() && Contacts.empty()) {
 		return;
 	}
-	UpdateEntityCollisions(entities);
+	UpdateEntityCollisions(world, entities);
 }
 
-void PhysicsService::UpdateEntityCollisions(const std::vector<Entity::Ptr>& entities)
+void PhysicsService::StepBodies(float deltaTime)
 {
-	CollisionTree.Clear();
-	for (const auto& entity : entities) {
-		if (entity->IsEnabled()) {
-			CollisionTree.Insert(entity.get());
+	const size_t count = Bodies.ActiveCount;
+	if (count == 0) {
+		return;
+	}
+
+	IntegrationParams params;
+	params.DeltaTime = deltaTime;
+	params.GravityY = Gravity.y;
+	params.TerminalVelocity = TerminalVelocity;
+	params.MinX = WorldBounds.x;
+	params.MaxX = WorldBounds.x + WorldBounds.width;
+	params.GroundLevel = GroundLevel;
+
+	// Bodies are independent, so each range gathers, integrates and scatters on its own.
+	auto step = [this, &params](size_t begin, size_t end) {
+		// Gather: entity positions may have been moved by gameplay since the last step.
+		for (size_t i = begin; i < end; ++i) {
+			const Entity* owner = Bodies.Owners[i];
+			const Vec2 position = owner->GetPosition();
+			Bodies.PositionX[i] = position.x;
+			Bodies.PositionY[i] = position.y;
+			Bodies.Width[i] = owner->GetBoundingRect().width;
+			// Completed by the scatter below, so only integrated motion counts and teleports don't.
+			Bodies.MotionX[i] -= position.x;
+			Bodies.MotionY[i] -= position.y;
+		}
+
+		IntegrateBodies(params, end - begin,
+			Bodies.PositionX.data() + begin, Bodies.PositionY.data() + begin,
+			Bodies.VelocityX.data() + begin, Bodies.VelocityY.data() + begin,
+			Bodies.AccelerationX.data() + begin, Bodies.AccelerationY.data() + begin,
+			Bodies.GravityScale.data() + begin, Bodies.Width.data() + begin);
+
+		for (size_t i = begin; i < end; ++i) {
+			Bodies.Owners[i]->SetPosition(Bodies.PositionX[i], Bodies.PositionY[i]);
+			Bodies.MotionX[i] += Bodies.PositionX[i];
+			Bodies.MotionY[i] += Bodies.PositionY[i];
 		}
+	};
+
+	if (auto* jobs = GetHost().TryGet<JobService>()) {
+		jobs->ParallelFor(count, ParallelBodyGrain, step);
+	} else {
+		step(0, count);
+	}
+}
+
+PhysicsBodyId PhysicsService::CreateBody(Entity& owner)
+{
+	PhysicsBodyId body;
+	if (!Bodies.FreeIds.empty()) {
+		body = Bodies.FreeIds.back();
+		Bodies.FreeIds.pop_back();
+	} else {
+		body = static_cast<PhysicsBodyId>(Bodies.BodyToDense.size());
+		Bodies.BodyToDense.push_back(0);
+	}
+
+	Bodies.BodyToDense[body] = static_cast<uint32_t>(Bodies.Size());
+	Bodies.DenseToBody.push_back(body);
+	Bodies.Owners.push_back(&owner);
+	Bodies.PositionX.push_back(owner.GetPosition().x);
+	Bodies.PositionY.push_back(owner.GetPosition().y);
+	Bodies.VelocityX.push_back(0.0f);
+	Bodies.VelocityY.push_back(0.0f);
+	Bodies.AccelerationX.push_back(0.0f);
+	Bodies.AccelerationY.push_back(0.0f);
+	Bodies.GravityScale.push_back(1.0f);
+	Bodies.Width.push_back(0.0f);
+	Bodies.MotionX.push_back(0.0f);
+	Bodies.MotionY.push_back(0.0f);
+	Bodies.Bullet.push_back(0);
+	SetBodyActive(body, owner.IsEnabled());
+	return body;
+}
+
+void PhysicsService::DestroyBody(PhysicsBodyId body)
+{
+	assert(body < Bodies.BodyToDense.size());
+	SetBodyActive(body, false);
+
+	const uint32_t last = static_cast<uint32_t>(Bodies.Size() - 1);
+	Bodies.Swap(Bodies.BodyToDense[body], last);
+	Bodies.ForEachColumn([](auto& column) { column.pop_back(); });
+	Bodies.FreeIds.push_back(body);
+}
+
+void PhysicsService::SetBodyActive(PhysicsBodyId body, bool active)
+{
+	const uint32_t index = Dense(body);
+	const uint32_t boundary = static_cast<uint32_t>(Bodies.ActiveCount);
+	if (active && index >= boundary) {
+		Bodies.Swap(index, boundary);
+		++Bodies.ActiveCount;
+		// Whatever it moved before it was pooled is not part of the next sweep.
+		Bodies.MotionX[boundary] = 0.0f;
+		Bodies.MotionY[boundary] = 0.0f;
+	} else if (!active && index < boundary) {
+		Bodies.Swap(index, boundary - 1);
+		--Bodies.ActiveCount;
 	}
+}
+
+void PhysicsService::BodyStorage::Swap(uint32_t a, uint32_t b)
+{
+	if (a == b) {
+		return;
+	}
+	ForEachColumn([a, b](auto& column) { std::swap(column[a], column[b]); });
+	BodyToDense[DenseToBody[a]] = a;
+	BodyToDense[DenseToBody[b]] = b;
+}
+
+Vec2 PhysicsService::GetBodyVelocity(PhysicsBodyId body) const
+{
+	const uint32_t index = Dense(body);
+	return Vec2(Bodies.VelocityX[index], Bodies.VelocityY[index]);
+}
+
+void PhysicsService::SetBodyVelocity(PhysicsBodyId body, const Vec2& velocity)
+{
+	const uint32_t index = Dense(body);
+	Bodies.VelocityX[index] = velocity.x;
+	Bodies.VelocityY[index] = velocity.y;
+}
+
+void PhysicsService::AddBodyAcceleration(PhysicsBodyId body, const Vec2& acceleration)
+{
+	const uint32_t index = Dense(body);
+	Bodies.AccelerationX[index] += acceleration.x;
+	Bodies.AccelerationY[index] += acceleration.y;
+}
 
+void PhysicsService::ClearBodyAcceleration(PhysicsBodyId body)
+{
+	const uint32_t index = Dense(body);
+	Bodies.AccelerationX[index] = 0.0f;
+	Bodies.AccelerationY[index] = 0.0f;
+}
+
+void PhysicsService::UpdateEntityCollisions(const World& world, const EntityRange& entities)
+{
+	++CollisionTick;
+	FrameProxies.clear();
+	MovingProxies.clear();
+	RestingProxies.clear();
+	size_t joinedResting = 0;
+	size_t stillResting = 0;
+	float extentLeft = 0.0f;
+	float extentTop = 0.0f;
+	float extentRight = 0.0f;
+	float extentBottom = 0.0f;
 	for (const auto& entity : entities) {
 		if (!entity->IsEnabled()) {
 			continue;
 		}
-		CollisionCandidates.clear();
-		CollisionTree.Query(entity->GetBoundingRect(), CollisionCandidates);
-		for (auto* other : CollisionCandidates) {
-			if (other == entity.get()) {
+		BroadphaseProxy proxy;
+		proxy.Handle = entity->GetHandle();
+		proxy.Bounds = entity->GetBoundingRect();
+		proxy.Layers = entity->GetCollisionLayers();
+		proxy.CollidesWith = GetCollisionMask(proxy.Layers);
+		if (proxy.Handle.Index >= ProxyLookup.size()) {
+			ProxyLookup.resize(proxy.Handle.Index + 1, 0);
+		}
+		ProxyLookup[proxy.Handle.Index] = static_cast<uint32_t>(FrameProxies.size());
+		const bool firstProxy = FrameProxies.empty();
+		extentLeft = firstProxy ? proxy.Bounds.Left() : std::min(extentLeft, proxy.Bounds.Left());
+		extentTop = firstProxy ? proxy.Bounds.Top() : std::min(extentTop, proxy.Bounds.Top());
+		extentRight = firstProxy ? proxy.Bounds.Right() : std::max(extentRight, proxy.Bounds.Right());
+		extentBottom = firstProxy ? proxy.Bounds.Bottom() : std::max(extentBottom, proxy.Bounds.Bottom());
+		FrameProxies.push_back(proxy);
+
+		bool wasResting;
+		if (UpdateRestState(*entity, proxy, wasResting)) {
+			RestingProxies.push_back(proxy);
+			++(wasResting ? stillResting : joinedResting);
+		} else {
+			MovingProxies.push_back(proxy);
+		}
+	}
+	ProxyExtent = Rectf(extentLeft, extentTop, extentRight - extentLeft, extentBottom - extentTop);
+	Broadphase->Update(MovingProxies);
+	if (RestingBroadphaseStale || joinedResting != 0 || stillResting != BuiltRestingCount) {
+		RestingBroadphase->Update(RestingProxies);
+		BuiltRestingCount = RestingProxies.size();
+		RestingBroadphaseStale = false;
+	}
+
+	// Stage one: read-only pair search, each thread appending to its own buffer. Only moving
+	// proxies search, against each other and against the resting ones.
+	auto* jobs = GetHost().TryGet<JobService>();
+	const size_t slotCount = jobs ? jobs->GetThreadSlotCount() : 1;
+	if (PairBuffers.size() < slotCount) {
+		PairBuffers.resize(slotCount);
+	}
+	for (auto& buffer : PairBuffers) {
+		buffer.clear();
+	}
+	assert(Broadphase->GetProxyCount() == MovingProxies.size());
+	auto findPairs = [this](size_t begin, size_t end) {
+		auto& buffer = PairBuffers[JobService::GetCurrentThreadSlot()];
+		Broadphase->FindPairsInRange(begin, end, buffer);
+		FindRestingPairsInRange(begin, end, buffer);
+	};
+	if (jobs) {
+		jobs->ParallelFor(MovingProxies.size(), ParallelPairGrain, findPairs);
+	} else {
+		findPairs(0, MovingProxies.size());
+	}
+
+	// Stage two: merge and order by handle, so callbacks run in the same order whatever the
+	// thread count or backend.
+	CandidatePairs.clear();
+	for (const auto& buffer : PairBuffers) {
+		CandidatePairs.insert(CandidatePairs.end(), buffer.begin(), buffer.end());
+	}
+	UpdateBulletPairs();
+	// Neither side of a resting pair has moved since it was last tested, so a contact
+	// between two of them still holds and one that wasn't touching still isn't.
+	for (const auto& contact : Contacts) {
+		if (IsResting(contact.First) && IsResting(contact.Second)) {
+			CandidatePairs.push_back(contact);
+		}
+	}
+	std::sort(CandidatePairs.begin(), CandidatePairs.end());
+	// Two bullets can each find the other, and a resting bullet's hit can also carry over.
+	const auto duplicates = std::unique(CandidatePairs.begin(), CandidatePairs.end(), [](const BroadphasePair& a, const BroadphasePair& b) {
+		return a.First == b.First && a.Second == b.Second;
+	});
+	CandidatePairs.erase(duplicates, CandidatePairs.end());
+	if (PixelCollision) {
+		RemovePixelMisses(world);
+	}
+	UpdateContacts(world);
+}
+
+void PhysicsService::UpdateBulletPairs()
+{
+	ProxyMotion.assign(FrameProxies.size(), Vec2(0.0f, 0.0f));
+	ProxyIsBullet.assign(FrameProxies.size(), 0);
+	BulletProxies.clear();
+	// Furthest any body moved per axis: a target can have crossed a bullet's path from that far away.
+	Vec2 reach(0.0f, 0.0f);
+	for (size_t i = 0; i < Bodies.ActiveCount; ++i) {
+		const Vec2 motion(Bodies.MotionX[i], Bodies.MotionY[i]);
+		Bodies.MotionX[i] = 0.0f;
+		Bodies.MotionY[i] = 0.0f;
+		const BroadphaseProxy* proxy = FindProxy(Bodies.Owners[i]->GetHandle());
+		if (!proxy) {
+			continue;
+		}
+		const uint32_t index = static_cast<uint32_t>(proxy - FrameProxies.data());
+		ProxyMotion[index] = motion;
+		reach.x = std::max(reach.x, std::fabs(motion.x));
+		reach.y = std::max(reach.y, std::fabs(motion.y));
+		if (Bodies.Bullet[i] != 0) {
+			ProxyIsBullet[index] = 1;
+			BulletProxies.push_back(index);
+		}
+	}
+	if (BulletProxies.empty()) {
+		return;
+	}
+
+	// The discrete pairs only saw where bullets ended up; the sweeps below replace them.
+	auto isBullet = [this](EntityHandle handle) {
+		return ProxyIsBullet[FindProxy(handle) - FrameProxies.data()] != 0;
+	};
+	const auto discrete = std::remove_if(CandidatePairs.begin(), CandidatePairs.end(), [&isBullet](const BroadphasePair& pair) {
+		return isBullet(pair.First) || isBullet(pair.Second);
+	});
+	CandidatePairs.erase(discrete, CandidatePairs.end());
+
+	for (const uint32_t index : BulletProxies) {
+		const BroadphaseProxy& proxy = FrameProxies[index];
+		if (proxy.CollidesWith == 0) {
+			continue;
+		}
+		const Vec2 motion = ProxyMotion[index];
+		const Rectf start = Offset(proxy.Bounds, motion * -1.0f);
+		QueryCandidates.clear();
+		const Rectf swept = SweptBounds(start, motion);
+		QueryBroadphases(Rectf(swept.x - reach.x, swept.y - reach.y, swept.width + reach.x * 2.0f, swept.height + reach.y * 2.0f),
+			proxy.CollidesWith, QueryCandidates);
+
+		EntityHandle earliest;
+		float earliestTime = 2.0f;
+		for (const auto candidate : QueryCandidates) {
+			if (candidate == proxy.Handle) {
 				continue;
 			}
-			if (!other->IsEnabled()) {
+			const uint32_t other = static_cast<uint32_t>(FindProxy(candidate) - FrameProxies.data());
+			const Vec2 otherMotion = ProxyMotion[other];
+			// Swept in the target's frame, so a target moving across the path is caught too.
+			float time;
+			if (SweepRects(start, motion - otherMotion, Offset(FrameProxies[other].Bounds, otherMotion * -1.0f), time)
+				&& (time < earliestTime || (time == earliestTime && candidate.Index < earliest.Index))) {
+				earliest = candidate;
+				earliestTime = time;
+			}
+		}
+		if (!earliest.IsValid()) {
+			continue;
+		}
+		if (proxy.Handle.Index < earliest.Index) {
+			CandidatePairs.push_back({ proxy.Handle, earliest });
+		} else {
+			CandidatePairs.push_back({ earliest, proxy.Handle });
+		}
+	}
+}
+
+void PhysicsService::RemovePixelMisses(const World& world)
+{
+	const auto misses = std::remove_if(CandidatePairs.begin(), CandidatePairs.end(), [this, &world](const BroadphasePair& pair) {
+		// A bullet's hit is where it passed through, not where its sprite is now.
+		if (ProxyIsBullet[FindProxy(pair.First) - FrameProxies.data()] != 0
+			|| ProxyIsBullet[FindProxy(pair.Second) - FrameProxies.data()] != 0) {
+			return false;
+		}
+		const Entity* first = world.Resolve(pair.First);
+		const Entity* second = world.Resolve(pair.Second);
+		return first && second && !PixelMask::SpritesOverlap(first->GetSprite(), second->GetSprite());
+	});
+	CandidatePairs.erase(misses, CandidatePairs.end());
+}
+
+bool PhysicsService::UpdateRestState(const Entity& entity, const BroadphaseProxy& proxy, bool& wasResting)
+{
+	if (proxy.Handle.Index >= RestStates.size()) {
+		RestStates.resize(proxy.Handle.Index + 1);
+	}
+	RestState& state = RestStates[proxy.Handle.Index];
+	const Sprite& sprite = entity.GetSprite();
+	const Recti frame = sprite.GetTextureRect();
+	const bool flipX = sprite.IsFlippedX();
+	const bool unchanged = state.Generation == proxy.Handle.Generation
+		&& state.LastTick + 1 == CollisionTick
+		&& state.Layers == proxy.Layers
+		&& state.Bounds.x == proxy.Bounds.x && state.Bounds.y == proxy.Bounds.y
+		&& state.Bounds.width == proxy.Bounds.width && state.Bounds.height == proxy.Bounds.height
+		&& state.Frame.x == frame.x && state.Frame.y == frame.y
+		&& state.Frame.width == frame.width && state.Frame.height == frame.height
+		&& state.FlipX == flipX;
+	wasResting = unchanged && state.Resting;
+
+	state.Generation = proxy.Handle.Generation;
+	state.LastTick = CollisionTick;
+	state.Bounds = proxy.Bounds;
+	state.Layers = proxy.Layers;
+	state.Frame = frame;
+	state.FlipX = flipX;
+	state.IdleTicks = unchanged ? state.IdleTicks + 1 : 0;
+	// A static entity that was moved counts as moving for that tick, so it is still tested
+	// against whatever it landed on.
+	state.Resting = unchanged && (entity.IsStatic() || (SleepTicks > 0 && state.IdleTicks >= SleepTicks));
+	return state.Resting;
+}
+
+bool PhysicsService::IsResting(EntityHandle handle) const
+{
+	if (handle.Index >= RestStates.size()) {
+		return false;
+	}
+	const RestState& state = RestStates[handle.Index];
+	return state.Generation == handle.Generation && state.LastTick == CollisionTick && state.Resting;
+}
+
+void PhysicsService::FindRestingPairsInRange(size_t begin, size_t end, std::vector<BroadphasePair>& pairs) const
+{
+	if (RestingBroadphase->GetProxyCount() == 0) {
+		return;
+	}
+	for (size_t index = begin; index < end; ++index) {
+		const BroadphaseProxy& proxy = MovingProxies[index];
+		if (proxy.CollidesWith == 0) {
+			continue;
+		}
+		QueryCandidates.clear();
+		RestingBroadphase->Query(proxy.Bounds, proxy.CollidesWith, QueryCandidates);
+		for (const auto candidate : QueryCandidates) {
+			// Backends with fat bounds over-report; pairs must be exact.
+			const BroadphaseProxy* other = FindProxy(candidate);
+			if (!other || !other->Bounds.Intersects(proxy.Bounds)) {
 				continue;
 			}
-			if (entity.get() < other && entity->Collision(other)) {
-				entity->OnCollide(*other);
-				other->OnCollide(*entity.get());
+			if (proxy.Handle.Index < candidate.Index) {
+				pairs.push_back({ proxy.Handle, candidate });
+			} else {
+				pairs.push_back({ candidate, proxy.Handle });
 			}
 		}
 	}
 }
+
+void PhysicsService::UpdateContacts(const World& world)
+{
+	// Both lists are sorted the same way, so one merge pass classifies every pair: only in
+	// the old list is an exit, only in the new one an enter, in both a stay.
+	PreviousContacts.swap(Contacts);
+	Contacts.clear();
+	size_t previous = 0;
+	size_t current = 0;
+	while (previous < PreviousContacts.size() || current < CandidatePairs.size()) {
+		if (current == CandidatePairs.size()
+			|| (previous < PreviousContacts.size() && PreviousContacts[previous] < CandidatePairs[current])) {
+			DispatchContact(world, PreviousContacts[previous++], CollisionEvent::Exit);
+			continue;
+		}
+
+		const BroadphasePair& pair = CandidatePairs[current++];
+		CollisionEvent event = CollisionEvent::Enter;
+		if (previous < PreviousContacts.size() && !(pair < PreviousContacts[previous])) {
+			const BroadphasePair& old = PreviousContacts[previous++];
+			// Same slots but a different generation: one side was destroyed and its slot reused.
+			if (old.First == pair.First && old.Second == pair.Second) {
+				event = CollisionEvent::Stay;
+			} else {
+				DispatchContact(world, old, CollisionEvent::Exit);
+			}
+		}
+		if (DispatchContact(world, pair, event)) {
+			Contacts.push_back(pair);
+		}
+	}
+}
+
+bool PhysicsService::DispatchContact(const World& world, const BroadphasePair& pair, CollisionEvent event)
+{
+	Entity* first = world.Resolve(pair.First);
+	Entity* second = world.Resolve(pair.Second);
+	// A destroyed side can't be passed to the survivor, so that contact just ends silently.
+	if (!first || !second) {
+		return false;
+	}
+
+	// Either side may have been disabled by an earlier callback this tick; a stay then ends
+	// the contact instead. Entity skips callbacks while disabled, so only the live side hears it.
+	if (event != CollisionEvent::Exit && (!first->IsEnabled() || !second->IsEnabled())) {
+		if (event == CollisionEvent::Enter) {
+			return false;
+		}
+		event = CollisionEvent::Exit;
+	}
+
+	// Pairs already passed the exact bounds test on this tick's proxies.
+	switch (event) {
+	case CollisionEvent::Enter:
+		first->OnCollisionEnter(*second);
+		RunCollisionResponses(*first, *second, event);
+		second->OnCollisionEnter(*first);
+		RunCollisionResponses(*second, *first, event);
+		return true;
+	case CollisionEvent::Stay:
+		first->OnCollisionStay(*second);
+		RunCollisionResponses(*first, *second, event);
+		second->OnCollisionStay(*first);
+		RunCollisionResponses(*second, *first, event);
+		return true;
+	case CollisionEvent::Exit:
+	default:
+		first->OnCollisionExit(*second);
+		RunCollisionResponses(*first, *second, event);
+		second->OnCollisionExit(*first);
+		RunCollisionResponses(*second, *first, event);
+		return false;
+	}
+}
+
+void PhysicsService::RunCollisionResponses(Entity& self, Entity& other, CollisionEvent event)
+{
+	const ENTITY_TAG selfTag = self.GetTag();
+	const ENTITY_TAG otherTag = other.GetTag();
+	// Like component hooks, a side that an earlier handler disabled hears nothing more.
+	if (!self.IsEnabled() || (RespondsTo[static_cast<size_t>(event)][selfTag] & LayerOf(otherTag)) == 0) {
+		return;
+	}
+	auto row = std::lower_bound(Responses.begin(), Responses.end(), std::make_tuple(selfTag, otherTag, event),
+		[](const CollisionResponse& response, const std::tuple<ENTITY_TAG, ENTITY_TAG, CollisionEvent>& key) {
+			return std::make_tuple(response.Self, response.Other, response.Event) < key;
+		});
+	for (; row != Responses.end() && row->Self == selfTag && row->Other == otherTag && row->Event == event; ++row) {
+		++row->Calls;
+		row->Handler(self, other);
+		if (!self.IsEnabled()) {
+			return;
+		}
+	}
+}
+
+void PhysicsService::RegisterCollisionHandler(const std::string& name, CollisionHandler handler)
+{
+	CollisionHandlers[name] = std::move(handler);
+}
+
+bool PhysicsService::AddCollisionResponse(ENTITY_TAG self, ENTITY_TAG other, CollisionEvent event, const std::string& handlerName)
+{
+	auto handler = CollisionHandlers.find(handlerName);
+	if (handler == CollisionHandlers.end()) {
+		return false;
+	}
+	CollisionResponse response;
+	response.Self = self;
+	response.Other = other;
+	response.Event = event;
+	response.HandlerName = handlerName;
+	response.Handler = handler->second;
+	// Rows for one key keep the order they were added in.
+	auto position = std::upper_bound(Responses.begin(), Responses.end(), response, [](const CollisionResponse& a, const CollisionResponse& b) {
+		return std::make_tuple(a.Self, a.Other, a.Event) < std::make_tuple(b.Self, b.Other, b.Event);
+	});
+	Responses.insert(position, std::move(response));
+	RespondsTo[static_cast<size_t>(event)][self] |= LayerOf(other);
+	return true;
+}
+
+void PhysicsService::ClearCollisionResponses()
+{
+	Responses.clear();
+	RespondsTo = {};
+}
+
+void PhysicsService::ResetCollisionResponseCounts()
+{
+	for (auto& response : Responses) {
+		response.Calls = 0;
+	}
+}
+
+namespace {
+	float DistanceSquaredToRect(const Vec2& point, const Rectf& rect)
+	{
+		const float dx = std::max({ rect.Left() - point.x, 0.0f, point.x - rect.Right() });
+		const float dy = std::max({ rect.Top() - point.y, 0.0f, point.y - rect.Bottom() });
+		return dx * dx + dy * dy;
+	}
+
+	// Slab test against a normalized ray; `distance` is where the ray enters the rect.
+	bool RayHitsRect(const Vec2& origin, const Vec2& direction, float maxDistance, const Rectf& rect, float& distance)
+	{
+		float enter = 0.0f;
+		float exit = maxDistance;
+		const float origins[2] = { origin.x, origin.y };
+		const float directions[2] = { direction.x, direction.y };
+		const float mins[2] = { rect.Left(), rect.Top() };
+		const float maxs[2] = { rect.Right(), rect.Bottom() };
+		for (int axis = 0; axis < 2; ++axis) {
+			if (std::fabs(directions[axis]) < 1.0e-8f) {
+				if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+					return false;
+				}
+				continue;
+			}
+			const float inverse = 1.0f / directions[axis];
+			float near = (mins[axis] - origins[axis]) * inverse;
+			float far = (maxs[axis] - origins[axis]) * inverse;
+			if (near > far) {
+				std::swap(near, far);
+			}
+			enter = std::max(enter, near);
+			exit = std::min(exit, far);
+			if (enter > exit) {
+				return false;
+			}
+		}
+		distance = enter;
+		return true;
+	}
+
+	// Bounding box of the segment the ray sweeps, for the broadphase pass.
+	Rectf RayBounds(const Vec2& origin, const Vec2& end)
+	{
+		const float left = std::min(origin.x, end.x);
+		const float top = std::min(origin.y, end.y);
+		// Inflated slightly so axis-aligned rays still have an area to overlap.
+		return Rectf(left - 0.5f, top - 0.5f, std::fabs(end.x - origin.x) + 1.0f, std::fabs(end.y - origin.y) + 1.0f);
+	}
+}
+
+void PhysicsService::QueryBroadphases(const Rectf& range, CollisionLayerMask layers, std::vector<EntityHandle>& found) const
+{
+	Broadphase->Query(range, layers, found);
+	RestingBroadphase->Query(range, layers, found);
+}
+
+const BroadphaseProxy* PhysicsService::FindProxy(EntityHandle handle) const
+{
+	if (handle.Index >= ProxyLookup.size()) {
+		return nullptr;
+	}
+	const uint32_t index = ProxyLookup[handle.Index];
+	if (index >= FrameProxies.size() || FrameProxies[index].Handle != handle) {
+		return nullptr;
+	}
+	return &FrameProxies[index];
+}
+
+void PhysicsService::QueryRect(const Rectf& range, CollisionLayerMask layers, std::vector<EntityHandle>& results) const
+{
+	const size_t first = results.size();
+	QueryBroadphases(range, layers, results);
+	// Backends with fat bounds over-report; keep only exact overlaps.
+	const auto exact = std::remove_if(results.begin() + first, results.end(), [this, &range](EntityHandle handle) {
+		const BroadphaseProxy* proxy = FindProxy(handle);
+		return !proxy || !proxy->Bounds.Intersects(range);
+	});
+	results.erase(exact, results.end());
+}
+
+void PhysicsService::QueryCircle(const Vec2& center, float radius, CollisionLayerMask layers, std::vector<EntityHandle>& results) const
+{
+	const size_t first = results.size();
+	QueryRect(Rectf(center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f), layers, results);
+	const float radiusSquared = radius * radius;
+	const auto inside = std::remove_if(results.begin() + first, results.end(), [this, &center, radiusSquared](EntityHandle handle) {
+		return DistanceSquaredToRect(center, FindProxy(handle)->Bounds) > radiusSquared;
+	});
+	results.erase(inside, results.end());
+}
+
+bool PhysicsService::Raycast(const Vec2& origin, const Vec2& direction, float maxDistance, CollisionLayerMask layers, RaycastHit& hit) const
+{
+	const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+	if (length <= 0.0f) {
+		return false;
+	}
+	const Vec2 unit = direction / length;
+
+	QueryCandidates.clear();
+	QueryBroadphases(RayBounds(origin, origin + unit * maxDistance), layers, QueryCandidates);
+	bool found = false;
+	float nearest = maxDistance;
+	for (const auto candidate : QueryCandidates) {
+		const BroadphaseProxy* proxy = FindProxy(candidate);
+		float distance;
+		if (proxy && RayHitsRect(origin, unit, nearest, proxy->Bounds, distance)) {
+			// Ties go to the lower handle so the answer does not depend on backend order.
+			if (!found || distance < nearest || (distance == nearest && candidate.Index < hit.Entity.Index)) {
+				hit.Entity = candidate;
+				hit.Distance = distance;
+				nearest = distance;
+				found = true;
+			}
+		}
+	}
+	if (found) {
+		hit.Point = origin + unit * hit.Distance;
+	}
+	return found;
+}
+
+void PhysicsService::RaycastAll(const Vec2& origin, const Vec2& direction, float maxDistance, CollisionLayerMask layers, std::vector<RaycastHit>& hits) const
+{
+	const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+	if (length <= 0.0f) {
+		return;
+	}
+	const Vec2 unit = direction / length;
+
+	QueryCandidates.clear();
+	QueryBroadphases(RayBounds(origin, origin + unit * maxDistance), layers, QueryCandidates);
+	const size_t first = hits.size();
+	for (const auto candidate : QueryCandidates) {
+		const BroadphaseProxy* proxy = FindProxy(candidate);
+		float distance;
+		if (proxy && RayHitsRect(origin, unit, maxDistance, proxy->Bounds, distance)) {
+			RaycastHit hit;
+			hit.Entity = candidate;
+			hit.Distance = distance;
+			hit.Point = origin + unit * distance;
+			hits.push_back(hit);
+		}
+	}
+	std::sort(hits.begin() + first, hits.end(), [](const RaycastHit& a, const RaycastHit& b) {
+		return a.Distance != b.Distance ? a.Distance < b.Distance : a.Entity.Index < b.Entity.Index;
+	});
+}
+
+EntityHandle PhysicsService::FindNearest(const Vec2& point, CollisionLayerMask layers, float maxDistance) const
+{
+	// Grow a square around the point until the best hit is provably inside it: anything
+	// outside a square of half-size r is further than r away.
+	if (FrameProxies.empty()) {
+		return EntityHandle();
+	}
+	// Past this every proxy is inside the square, so growing further finds nothing new.
+	const float extentReach = std::max({ point.x - ProxyExtent.Left(), ProxyExtent.Right() - point.x,
+		point.y - ProxyExtent.Top(), ProxyExtent.Bottom() - point.y, 0.0f }) + 1.0f;
+	const float maxReach = std::min(maxDistance, extentReach);
+	float reach = std::min(64.0f, maxReach);
+	const float maxDistanceSquared = maxDistance * maxDistance;
+	for (;;) {
+		QueryCandidates.clear();
+		QueryBroadphases(Rectf(point.x - reach, point.y - reach, reach * 2.0f, reach * 2.0f), layers, QueryCandidates);
+
+		EntityHandle nearest;
+		float nearestSquared = maxDistanceSquared;
+		for (const auto candidate : QueryCandidates) {
+			const BroadphaseProxy* proxy = FindProxy(candidate);
+			if (!proxy) {
+				continue;
+			}
+			const float distanceSquared = DistanceSquaredToRect(point, proxy->Bounds);
+			if (distanceSquared < nearestSquared
+				|| (distanceSquared == nearestSquared && nearest.IsValid() && candidate.Index < nearest.Index)) {
+				nearest = candidate;
+				nearestSquared = distanceSquared;
+			}
+		}
+
+		if ((nearest.IsValid() && nearestSquared <= reach * reach) || reach >= maxReach) {
+			return nearest;
+		}
+		reach = std::min(reach * 2.0f, maxReach);
+	}
+}
@@ -1,4 +1,6 @@
 #include <core/engine/RunnerService.h>
+#include <core/engine/GameServiceHost.h>
+#include <algorithm>
 
 void RunnerService::Init()
 {
@@ -6,6 +8,9 @@ void RunnerService::Init()
 	LastTime = SDL_GetPerformanceCounter();
 	DeltaTimeValue = 0.0f;
 	ElapsedTime = 0.0f;
+	FrameDeltaTime = 0.0f;
+	Accumulator = 0.0f;
+	InterpolationAlpha = 1.0f;
 	Started = true;
 }
 
@@ -13,13 +18,36 @@ void RunnerService::Update()
 {
 	if (!Started) {
 		Init();
-		return;
 	}
 
 	Uint64 currentTime = SDL_GetPerformanceCounter();
-	DeltaTimeValue = static_cast<float>(currentTime - LastTime) / static_cast<float>(Frequency);
+	FrameDeltaTime = static_cast<float>(currentTime - LastTime) / static_cast<float>(Frequency);
 	LastTime = currentTime;
-	ElapsedTime += DeltaTimeValue;
+
+	if (!IsFixedTimestep()) {
+		InterpolationAlpha = 1.0f;
+		RunStep(FrameDeltaTime);
+		return;
+	}
+
+	Accumulator += std::min(FrameDeltaTime, MaxFrameTime);
+	int steps = 0;
+	while (Accumulator >= FixedDeltaTime && steps < MaxStepsPerFrame) {
+		Accumulator -= FixedDeltaTime;
+		RunStep(FixedDeltaTime);
+		++steps;
+	}
+	if (steps == MaxStepsPerFrame) {
+		Accumulator = std::min(Accumulator, FixedDeltaTime);
+	}
+	InterpolationAlpha = Accumulator / FixedDeltaTime;
+}
+
+void RunnerService::SetFixedTickRate(float ticksPerSecond)
+{
+	FixedDeltaTime = ticksPerSecond > 0.0f ? 1.0f / ticksPerSecond : 0.0f;
+	Accumulator = 0.0f;
+	InterpolationAlpha = 1.0f;
 }
 
 void RunnerService::ResetClock()
@@ -27,4 +55,14 @@ void RunnerService::ResetClock()
 	LastTime = SDL_GetPerformanceCounter();
 	ElapsedTime = 0.0f;
 	DeltaTimeValue = 0.0f;
+	FrameDeltaTime = 0.0f;
+	Accumulator = 0.0f;
+	InterpolationAlpha = 1.0f;
+}
+
+void RunnerService::RunStep(float deltaTime)
+{
+	DeltaTimeValue = deltaTime;
+	ElapsedTime += deltaTime;
+	GetHost().FixedUpdate();
 }
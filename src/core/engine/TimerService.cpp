@@ -2,7 +2,7 @@
 #include <core/engine/RunnerService.h>
 #include <algorithm>
 
-void TimerService::Update()
+void TimerService::FixedUpdate()
 {
 	float currentTime = GetHost().Get<RunnerService>().GetElapsedTime();
 	for (auto it = Timers.begin(); it != Timers.end(); ) {
@@ -1,6 +1,7 @@
 #include <core/engine/WorldService.h>
 #include <core/GameMode.h>
 #include <core/World.h>
+#include <core/engine/PhysicsService.h>
 #include <core/engine/RunnerService.h>
 #include <core/engine/TimerService.h>
 #include <cassert>
@@ -19,7 +20,7 @@ void WorldService::Init()
 	SceneInitialized = true;
 }
 
-void WorldService::Update()
+void WorldService::FixedUpdate()
 {
 	assert(WorldContext);
 
@@ -27,18 +28,42 @@ void WorldService::Update()
 		Init();
 	}
 
+	auto& runner = GetHost().Get<RunnerService>();
+	if (runner.IsFixedTimestep()) {
+		WorldContext->SavePreviousPositions();
+	}
 	WorldContext->Start();
 	if (Mode) {
 		Mode->Update();
 	}
 	WorldContext->Update();
+	if (auto* physics = GetHost().TryGet<PhysicsService>()) {
+		physics->StepBodies(runner.GetDeltaTime());
+	}
 	WorldContext->PostUpdate();
 	if (Mode) {
 		Mode->PostUpdate();
 	}
+}
+
+void WorldService::Update()
+{
+	assert(WorldContext);
+
+	if (!SceneInitialized) {
+		Init();
+	}
+
 	WorldContext->Render();
 }
 
+void WorldService::Shutdown()
+{
+	// Entities own handles into other services (e.g. physics bodies), so tear them down while those services still exist.
+	WorldContext.reset();
+	SceneInitialized = false;
+}
+
 void WorldService::SetGameMode(GameMode* mode)
 {
 	Mode = mode;
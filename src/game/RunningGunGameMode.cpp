@@ -10,6 +10,10 @@
 #include <game/components/PlayerComponent.h>
 #include <cassert>
 
+namespace {
+	constexpr StringId ScorpionPrefab("scorpion");
+}
+
 RunningGunGameMode::RunningGunGameMode(SDL_Renderer* _renderer, GameServiceHost& _services, PrefabSystem& _prefabs, World& _world)
 	:Renderer(_renderer),
 	Services(_services),
@@ -18,10 +22,6 @@ RunningGunGameMode::RunningGunGameMode(SDL_Renderer* _renderer, GameServiceHost&
 	HealthBar(nullptr),
 	StatusTextUI(nullptr),
 	GameFont(nullptr),
-	PlayerEntity(nullptr),
-	BullEntity(nullptr),
-	PlayerComponentRef(nullptr),
-	BullComponentRef(nullptr),
 	SpawnScorpion1Interval(10.0f),
 	LastSpawn1Time(0.0f),
 	SpawnScorpion2Interval(11.0f),
@@ -36,7 +36,8 @@ RunningGunGameMode::RunningGunGameMode(SDL_Renderer* _renderer, GameServiceHost&
 
 RunningGunGameMode::~RunningGunGameMode()
 {
-	UnsubscribeFromEvents();
+	// No unsubscribe here: the delegates live on the player/bull components, which the world
+	// has already destroyed by the time the engine releases the mode.
 	if (GameFont) {
 		TTF_CloseFont(GameFont);
 	}
@@ -69,21 +70,25 @@ void RunningGunGameMode::BuildScene()
 	auto& _handler = Services.Get<RenderService>().GetTextureHandler();
 	auto _player = Prefabs.Instantiate("player");
 	assert(_player);
-	PlayerEntity = _player.get();
-	PlayerComponentRef = PlayerEntity->GetComponent<PlayerComponent>();
+	Entity* _playerEntity = _player.get();
 	WorldContext.AddObject(std::move(_player));
+	PlayerEntity = _playerEntity->GetHandle();
 	WorldContext.SetCameraTarget(PlayerEntity);
 
 	auto _bull = Prefabs.Instantiate("bull");
 	assert(_bull);
-	BullEntity = _bull.get();
-	BullComponentRef = BullEntity->GetComponent<BullComponent>();
+	Entity* _bullEntity = _bull.get();
 	WorldContext.AddObject(std::move(_bull));
+	BullEntity = _bullEntity->GetHandle();
 
 	LastSpawn1Time = 0.0f;
 	LastSpawn2Time = 0.0f;
 	Services.Get<RunnerService>().ResetClock();
 	Services.Get<TimerService>().Reset();
+
+	//instantiate projectiles and spawns now rather than during the first volley; after the
+	//clock reset, so pool maintenance is scheduled from this run's time
+	Services.Get<ObjectPoolService>().PrewarmPools();
 	Win = false;
 	Lose = false;
 
@@ -100,9 +105,10 @@ void RunningGunGameMode::BuildScene()
 		StatusTextUI->SetAnchor(UIAnchor::Center);
 		StatusTextUI->SetVisible(false);
 
-		if (PlayerComponentRef) {
-			HealthBar->SetHealthGetter([this]() { return PlayerComponentRef->GetHealth(); });
-		}
+		HealthBar->SetHealthGetter([this]() {
+			const PlayerComponent* _player = GetPlayerComponent();
+			return _player ? _player->GetHealth() : 0;
+		});
 		SetStatusText("");
 	}
 }
@@ -115,7 +121,7 @@ void RunningGunGameMode::PostUpdate()
 {
 	if (!Win && !Lose) {
 		if (Services.Get<RunnerService>().GetElapsedTime() - LastSpawn1Time > SpawnScorpion1Interval) {
-			auto* _scorpion = Services.Get<ObjectPoolService>().FetchPrefab("scorpion");
+			auto* _scorpion = Services.Get<ObjectPoolService>().FetchPrefab(ScorpionPrefab);
 			if (_scorpion != nullptr) {
 				_scorpion->SetPosition(50, 20);
 				_scorpion->SetDirection(1, 0);
@@ -124,7 +130,7 @@ void RunningGunGameMode::PostUpdate()
 		}
 
 		if (Services.Get<RunnerService>().GetElapsedTime() - LastSpawn2Time > SpawnScorpion2Interval) {
-			auto* _scorpion = Services.Get<ObjectPoolService>().FetchPrefab("scorpion");
+			auto* _scorpion = Services.Get<ObjectPoolService>().FetchPrefab(ScorpionPrefab);
 			if (_scorpion != nullptr) {
 				_scorpion->SetPosition(400, 20);
 				_scorpion->SetDirection(-1, 0);
@@ -145,8 +151,8 @@ void RunningGunGameMode::PostUpdate()
 void RunningGunGameMode::OnWin(Entity* _boss)
 {
 	Win = true;
-	if (PlayerEntity) {
-		PlayerEntity->Disable();
+	if (Entity* _player = WorldContext.Resolve(PlayerEntity)) {
+		_player->Disable();
 	}
 	SetStatusText("You Win!");
 }
@@ -169,14 +175,14 @@ void RunningGunGameMode::RequestReset()
 
 void RunningGunGameMode::SubscribeToEvents()
 {
-	if (PlayerComponentRef) {
-		PlayerDiedHandle = PlayerComponentRef->OnDied.Subscribe([this](Entity* _player) {
+	if (PlayerComponent* _playerComponent = GetPlayerComponent()) {
+		PlayerDiedHandle = _playerComponent->OnDied.Subscribe([this](Entity* _player) {
 			OnLose(_player);
 		});
 	}
 
-	if (BullComponentRef) {
-		BossDiedHandle = BullComponentRef->OnDied.Subscribe([this](Entity* _boss) {
+	if (BullComponent* _bullComponent = GetBullComponent()) {
+		BossDiedHandle = _bullComponent->OnDied.Subscribe([this](Entity* _boss) {
 			OnWin(_boss);
 		});
 	}
@@ -184,17 +190,34 @@ void RunningGunGameMode::SubscribeToEvents()
 
 void RunningGunGameMode::UnsubscribeFromEvents()
 {
-	if (PlayerComponentRef && PlayerDiedHandle != 0) {
-		PlayerComponentRef->OnDied.Unsubscribe(PlayerDiedHandle);
+	//a stale handle means the component, and its subscriptions, are already gone
+	if (PlayerDiedHandle != 0) {
+		if (PlayerComponent* _player = GetPlayerComponent()) {
+			_player->OnDied.Unsubscribe(PlayerDiedHandle);
+		}
 		PlayerDiedHandle = 0;
 	}
 
-	if (BullComponentRef && BossDiedHandle != 0) {
-		BullComponentRef->OnDied.Unsubscribe(BossDiedHandle);
+	if (BossDiedHandle != 0) {
+		if (BullComponent* _bull = GetBullComponent()) {
+			_bull->OnDied.Unsubscribe(BossDiedHandle);
+		}
 		BossDiedHandle = 0;
 	}
 }
 
+PlayerComponent* RunningGunGameMode::GetPlayerComponent() const
+{
+	Entity* _player = WorldContext.Resolve(PlayerEntity);
+	return _player ? _player->GetComponent<PlayerComponent>() : nullptr;
+}
+
+BullComponent* RunningGunGameMode::GetBullComponent() const
+{
+	Entity* _bull = WorldContext.Resolve(BullEntity);
+	return _bull ? _bull->GetComponent<BullComponent>() : nullptr;
+}
+
 void RunningGunGameMode::SetStatusText(const std::string& _text)
 {
 	if (StatusTextUI) {
@@ -1,6 +1,7 @@
 #include <game/app/RunningGunApp.h>
 #include <core/engine/Engine.h>
 #include <core/InputManager.h>
+#include <core/engine/PhysicsService.h>
 #include <core/engine/RenderService.h>
 #include <game/RunningGunGameMode.h>
 #include <game/components/ComponentRegistration.h>
@@ -20,7 +21,14 @@ int RunningGunApp::Run()
 	}
 
 	RegisterDefaultComponents(_engine.GetPrefabs().GetRegistry(), _inputConfig);
+	auto& _physics = _engine.GetServices().Get<PhysicsService>();
+	RegisterDefaultCollisionResponses(_physics);
 	_engine.GetPrefabs().LoadFromFile("config/prefabs.json", _engine.GetServices().Get<RenderService>().GetTextureHandler());
+	for (const auto& _response : _engine.GetPrefabs().GetCollisionResponses()) {
+		if (!_physics.AddCollisionResponse(_response.Self, _response.Other, _response.Event, _response.Handler)) {
+			SDL_Log("Unknown collision handler '%s'.", _response.Handler.c_str());
+		}
+	}
 
 	_engine.SetGameMode(std::make_unique<RunningGunGameMode>(
 		_engine.GetRenderer(),
@@ -5,18 +5,26 @@
 #include <core/engine/ObjectPoolService.h>
 #include <memory>
 
-
+namespace {
+	constexpr StringId DefaultState("DefaultState");
+	constexpr StringId DefaultAnimation("default");
+	constexpr StringId ShootAnimation("shoot");
+	constexpr StringId DamageAnimation("damage");
+	constexpr StringId DieAnimation("die");
+	constexpr StringId WavesPrefab("waves");
+}
 
 BullComponent::BullComponent(Entity& _entity, GameServiceHost& _context)
 	:Component(_entity, _context),
+	Lives(45),
 	Offset1(0,32),
 	Offset2(0,55),
 	ProjectileOffset(Offset1),
-	Lives(45)
+	Pools(_context)
 {
 	std::unique_ptr<BullDefaultState> _defaultState(new BullDefaultState(*this));
 
-	AddState("DefaultState", std::move(_defaultState));
+	AddState(DefaultState, std::move(_defaultState));
 
 	ParentEntity.SetDirection(-1, 0);
 
@@ -29,30 +37,26 @@ BullComponent::~BullComponent()
 
 void BullComponent::Start()
 {
-	SwitchState("DefaultState");
+	SwitchState(DefaultState);
 	Animator = ParentEntity.GetAnimator();
 }
 
 void BullComponent::Update()
 {
 	CurrentState->Update(); 
-	Animator->PlayAnimation("default");
-}
-
-void BullComponent::PostUpdate()
-{
+	Animator->PlayAnimation(DefaultAnimation);
 }
 
 void BullComponent::Shoot()
 {
-	auto* _projectile = Context.Get<ObjectPoolService>().FetchPrefab("waves");
+	auto* _projectile = Pools->FetchPrefab(WavesPrefab);
 	if (_projectile != nullptr) {
 		if (auto* _projectileComponent = _projectile->GetComponent<ProjectileComponent>()) {
-			_projectileComponent->Activate(&ParentEntity);
+			_projectileComponent->Activate(ParentEntity);
 		}
 		_projectile->SetPosition(ParentEntity.GetPosition() + ProjectileOffset);
 		SwitchShootPositions();
-		Animator->PlayAnimation("shoot");
+		Animator->PlayAnimation(ShootAnimation);
 	}
 }
 
@@ -61,12 +65,22 @@ void BullComponent::SwitchShootPositions() {
 	else ProjectileOffset = Offset1;
 }
 
-void BullComponent::AddState(const std::string& _id, BullStatePtr _state)
+void BullComponent::AddState(StringId _id, BullStatePtr _state)
 {
 	States.insert(std::make_pair(_id, std::move(_state)));
 }
 
-void BullComponent::SwitchState(const std::string& _id)
+void BullComponent::AddState(std::string_view _id, BullStatePtr _state)
+{
+	AddState(StringId::Intern(_id), std::move(_state));
+}
+
+void BullComponent::SwitchState(std::string_view _id)
+{
+	SwitchState(StringId(_id));
+}
+
+void BullComponent::SwitchState(StringId _id)
 {
 	auto _nextState = States.find(_id);
 	//if it can't access the state, we need to close it
@@ -79,20 +93,13 @@ void BullComponent::SwitchState(const std::string& _id)
 	CurrentState->EnterState();
 }
 
-void BullComponent::OnCollide(Entity& _other)
-{
-	if (_other.GetTag() == bullet) {
-		Damage();
-	}
-}
-
 void BullComponent::Damage() {
-	Animator->PlayAnimation("damage");
+	Animator->PlayAnimation(DamageAnimation);
 	Lives--;
 	if (Lives <= 0) {
 		// Broadcast through component's own delegate
 		OnDied.Broadcast(&ParentEntity);
-		Animator->PlayAnimation("die");
+		Animator->PlayAnimation(DieAnimation);
 		ParentEntity.Disable();
 	}
 }
@@ -3,6 +3,7 @@
 #include <core/engine/GameServiceHost.h>
 #include <core/Entity.h>
 #include <core/Json.h>
+#include <core/engine/PhysicsService.h>
 #include <game/components/BullComponent.h>
 #include <game/components/PatrolAIComponent.h>
 #include <game/components/PhysicsComponent.h>
@@ -31,14 +32,17 @@ void RegisterDefaultComponents(ComponentRegistry& registry, const PlayerInputCon
 	});
 	registry.Register("physics", [](Entity& entity, GameServiceHost& context, std::string_view paramsJson) {
 		float gravityScale = 1.0f;
+		bool bullet = false;
 		if (!paramsJson.empty()) {
 			auto result = Json::Parse(std::string(paramsJson));
 			if (!result.error()) {
 				gravityScale = static_cast<float>(Json::GetDouble(result.value(), "gravityScale", gravityScale));
+				bullet = Json::GetBool(result.value(), "bullet", bullet);
 			}
 		}
 		auto component = std::make_unique<PhysicsComponent>(entity, context);
 		component->SetGravityScale(gravityScale);
+		component->SetBullet(bullet);
 		return component;
 	});
 	registry.Register("patrol_ai", [](Entity& entity, GameServiceHost& context, std::string_view paramsJson) {
@@ -67,3 +71,40 @@ void RegisterDefaultComponents(ComponentRegistry& registry, const PlayerInputCon
 		return std::make_unique<ProjectileComponent>(entity, context, speed, lifeSpan);
 	});
 }
+
+void RegisterDefaultCollisionResponses(PhysicsService& physics)
+{
+	physics.RegisterCollisionHandler("player_damage", [](Entity& self, Entity&) {
+		if (auto* player = self.GetComponent<PlayerComponent>()) {
+			player->OnDamage();
+		}
+	});
+	physics.RegisterCollisionHandler("boss_damage", [](Entity& self, Entity&) {
+		if (auto* bull = self.GetComponent<BullComponent>()) {
+			bull->Damage();
+		}
+	});
+	physics.RegisterCollisionHandler("patrol_damage", [](Entity& self, Entity&) {
+		if (auto* patrol = self.GetComponent<PatrolAIComponent>()) {
+			patrol->Damage();
+		}
+	});
+	physics.RegisterCollisionHandler("projectile_hit", [](Entity& self, Entity& other) {
+		if (auto* projectile = self.GetComponent<ProjectileComponent>()) {
+			projectile->OnHit(other);
+		}
+	});
+
+	// Stay as well as enter: a hazard still overlapping once invulnerability ends hurts again.
+	for (const auto event : { CollisionEvent::Enter, CollisionEvent::Stay }) {
+		physics.AddCollisionResponse(player, hazard, event, "player_damage");
+		physics.AddCollisionResponse(player, enemy_bullet, event, "player_damage");
+	}
+	physics.AddCollisionResponse(hazard, bullet, CollisionEvent::Enter, "boss_damage");
+	physics.AddCollisionResponse(hazard, bullet, CollisionEvent::Enter, "patrol_damage");
+	physics.AddCollisionResponse(bullet, hazard, CollisionEvent::Enter, "projectile_hit");
+	physics.AddCollisionResponse(bullet, pickup, CollisionEvent::Enter, "projectile_hit");
+	// Enemy shots pass through hazards, so scorpions don't shield the player from the bull.
+	physics.AddCollisionResponse(enemy_bullet, player, CollisionEvent::Enter, "projectile_hit");
+	physics.AddCollisionResponse(enemy_bullet, pickup, CollisionEvent::Enter, "projectile_hit");
+}
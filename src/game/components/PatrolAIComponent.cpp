@@ -5,10 +5,16 @@
 #include <core/animation/AnimationStateMachine.h>
 #include <game/components/PhysicsComponent.h>
 
+namespace {
+	constexpr StringId IdleAnimation("idle");
+	constexpr StringId DamageAnimation("damage");
+}
+
 PatrolAIComponent::PatrolAIComponent(Entity& _entity, GameServiceHost& _context, float _speed)
 	:Component(_entity, _context),
 	MoveSpeed(_speed),
-	PhysicsHandle(nullptr)
+	PhysicsHandle(nullptr),
+	Runner(_context)
 {
 }
 
@@ -21,7 +27,7 @@ void PatrolAIComponent::Start()
 {
 	Lives = 2;
 	Animator = ParentEntity.GetAnimator();
-	LastTurnAround = Context.Get<RunnerService>().GetElapsedTime();
+	LastTurnAround = Runner->GetElapsedTime();
 	PhysicsHandle = ParentEntity.GetComponent<PhysicsComponent>();
 }
 
@@ -32,7 +38,7 @@ void PatrolAIComponent::Update()
 		_patrolVelocity.y = PhysicsHandle->GetVelocity().y;
 		_patrolVelocity.x *= MoveSpeed;
 		PhysicsHandle->SetVelocity(_patrolVelocity);
-		float _currentTime = Context.Get<RunnerService>().GetElapsedTime();
+		float _currentTime = Runner->GetElapsedTime();
 
 		if (_currentTime - Interval > LastTurnAround) {
 			ChangeDirection();
@@ -47,7 +53,7 @@ void PatrolAIComponent::Update()
 void PatrolAIComponent::PostUpdate()
 {
 	ParentEntity.GetSprite().SetFlipX(ParentEntity.GetDirection().x < 0);
-	Animator->PlayAnimation("idle");
+	Animator->PlayAnimation(IdleAnimation);
 }
 
 void PatrolAIComponent::ChangeDirection()
@@ -55,13 +61,6 @@ void PatrolAIComponent::ChangeDirection()
 	ParentEntity.SetDirection(ParentEntity.GetDirection() * -1.0f);
 }
 
-void PatrolAIComponent::OnCollide(Entity& _other)
-{
-	if (_other.GetTag() == bullet) {
-		Damage();
-	}
-}
-
 void PatrolAIComponent::Damage()
 {
 	Lives--;
@@ -70,7 +69,7 @@ void PatrolAIComponent::Damage()
 		return;
 	}
 	ParentEntity.GetSprite().SetFlipX(ParentEntity.GetDirection().x < 0);
-	Animator->PlayAnimation("damage");
+	Animator->PlayAnimation(DamageAnimation);
 }
 
 //absolutely useless
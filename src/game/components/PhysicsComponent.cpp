@@ -1,108 +1,77 @@
 #include <game/components/PhysicsComponent.h>
+#include <core/Entity.h>
 #include <core/engine/GameServiceHost.h>
-#include <core/engine/PhysicsService.h>
-#include <core/engine/RunnerService.h>
-#include <algorithm>
 #include <cmath>
 
 PhysicsComponent::PhysicsComponent(Entity& _entity, GameServiceHost& _context)
 	:Component(_entity, _context),
 	PhysContext(_context.Get<PhysicsService>()),
-	Velocity(0.0f, 0.0f),
-	AccumulatedAcceleration(0.0f, 0.0f),
-	GravityScale(1.0f)
+	Body(PhysContext.CreateBody(_entity))
 {
-	
 }
 
 
 PhysicsComponent::~PhysicsComponent()
 {
+	PhysContext.DestroyBody(Body);
 }
 
-void PhysicsComponent::Update()
+void PhysicsComponent::Start()
 {
-	const float _deltaTime = Context.Get<RunnerService>().GetDeltaTime();
-	if (AccumulatedAcceleration.x != 0.0f || AccumulatedAcceleration.y != 0.0f) {
-		Velocity += (AccumulatedAcceleration * _deltaTime);
-		AccumulatedAcceleration = Vec2(0.0f, 0.0f);
-	}
-
-	const float _gravityAccel = PhysContext.GetGravity().y * GravityScale;
-	const float _terminalVelocity = PhysContext.GetTerminalVelocity();
-	if (_gravityAccel > 0.0f && Velocity.y < _terminalVelocity) {
-		float _result = Velocity.y + _gravityAccel * _deltaTime;
-		Velocity.y = std::min(_result, _terminalVelocity);
-	}
-
-	auto _position = ParentEntity.GetPosition();
-	_position += (Velocity * _deltaTime);
-	ParentEntity.SetPosition(_position);
+	PhysContext.SetBodyActive(Body, true);
 }
 
-void PhysicsComponent::PostUpdate()
+void PhysicsComponent::OnDisable()
 {
-	auto _position = ParentEntity.GetPosition();
-	const auto& _bounds = PhysContext.GetWorldBounds();
-
-	_position.x = std::max(_position.x, _bounds.x);
-	_position.x = std::min(_position.x, _bounds.x + _bounds.w - ParentEntity.GetWidth());
-	_position.y = std::min(_position.y, PhysContext.GetGroundLevel());
-	ParentEntity.SetPosition(_position);
+	PhysContext.SetBodyActive(Body, false);
 }
 
 Vec2 PhysicsComponent::GetVelocity() const
 {
-	return Velocity;
+	return PhysContext.GetBodyVelocity(Body);
 }
 
 void PhysicsComponent::SetVelocity(const Vec2& _velocity)
 {
-	Velocity = _velocity;
+	PhysContext.SetBodyVelocity(Body, _velocity);
 }
 
 void PhysicsComponent::SetVelocity(float _x, float _y)
 {
-	Velocity.x = _x;
-	Velocity.y = _y;
+	PhysContext.SetBodyVelocity(Body, Vec2(_x, _y));
 }
 
 void PhysicsComponent::SetVelocityX(float _x)
 {
-	Velocity.x = _x;
+	PhysContext.SetBodyVelocityX(Body, _x);
 }
 
 void PhysicsComponent::SetVelocityY(float _y)
 {
-	Velocity.y = _y;
+	PhysContext.SetBodyVelocityY(Body, _y);
 }
 
 void PhysicsComponent::AddVelocity(const Vec2& _delta)
 {
-	Velocity += _delta;
+	PhysContext.SetBodyVelocity(Body, PhysContext.GetBodyVelocity(Body) + _delta);
 }
 
 void PhysicsComponent::AddAcceleration(const Vec2& _acceleration)
 {
-	AccumulatedAcceleration += _acceleration;
+	PhysContext.AddBodyAcceleration(Body, _acceleration);
 }
 
 void PhysicsComponent::ClearAcceleration()
 {
-	AccumulatedAcceleration = Vec2(0.0f, 0.0f);
+	PhysContext.ClearBodyAcceleration(Body);
 }
 
 void PhysicsComponent::SetGravityScale(float _scale)
 {
-	GravityScale = _scale;
+	PhysContext.SetBodyGravityScale(Body, _scale);
 }
 
 bool PhysicsComponent::IsGrounded() const
 {
 	return (std::abs(ParentEntity.GetPosition().y - PhysContext.GetGroundLevel())) <= 0.3f;
 }
-
-void PhysicsComponent::OnCollide(Entity& _other)
-{
-
-}
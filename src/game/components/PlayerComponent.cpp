@@ -9,6 +9,14 @@
 #include <core/engine/RunnerService.h>
 #include <core/MathUtils.h>
 
+namespace {
+	constexpr StringId WalkAnimation("walk");
+	constexpr StringId IdleAnimation("idle");
+	constexpr StringId ShootAnimation("shoot");
+	constexpr StringId DamageAnimation("damage");
+	constexpr StringId BulletPrefab("bullet");
+}
+
 PlayerComponent::PlayerComponent(Entity& _entity, GameServiceHost& _context, const PlayerInputConfig& _inputConfig)
 	:Component(_entity, _context),
 	Lives(5),
@@ -27,7 +35,10 @@ PlayerComponent::PlayerComponent(Entity& _entity, GameServiceHost& _context, con
 	MoveRightActionHandle(std::make_unique<MoveRightAction>()),
 	JumpActionHandle(std::make_unique<JumpAction>()),
 	ShootActionHandle(std::make_unique<ShootAction>()),
-	InputConfig(_inputConfig)
+	InputConfig(_inputConfig),
+	Runner(_context),
+	Input(_context),
+	Pools(_context)
 {
 	//set initial direction (right)
 	ParentEntity.SetDirection(1, 0);
@@ -52,7 +63,7 @@ void PlayerComponent::Update()
 {
 	// Check invulnerability cooldown
 	if (IsInvulnerable) {
-		if (Context.Get<RunnerService>().GetElapsedTime() >= InvulnerabilityEndTime) {
+		if (Runner->GetElapsedTime() >= InvulnerabilityEndTime) {
 			IsInvulnerable = false;
 		}
 	}
@@ -76,9 +87,9 @@ void PlayerComponent::HandleAnimations()
 	Vec2 _velocity = PhysicsHandle ? PhysicsHandle->GetVelocity() : Vec2(0.0f, 0.0f);
 
 	if (_velocity.x != 0) {
-		Animator->PlayAnimation("walk");
+		Animator->PlayAnimation(WalkAnimation);
 	} else {
-		Animator->PlayAnimation("idle");
+		Animator->PlayAnimation(IdleAnimation);
 	}
 
 }
@@ -86,11 +97,11 @@ void PlayerComponent::HandleAnimations()
 void PlayerComponent::ShootBullet()
 {
 	//update the shooting cooldown
-	auto _currentTime = Context.Get<RunnerService>().GetElapsedTime();
+	auto _currentTime = Runner->GetElapsedTime();
 	if (_currentTime - BulletCoolDown > LastShotTime) {
 		LastShotTime = _currentTime;
 		//borrow bullet from object pool
-		auto* _bullet = Context.Get<ObjectPoolService>().FetchPrefab("bullet");
+		auto* _bullet = Pools->FetchPrefab(BulletPrefab);
 
 		//set position based off of player's direction
 		auto _position = ParentEntity.GetPosition();
@@ -99,13 +110,13 @@ void PlayerComponent::ShootBullet()
 		_position.y += BulletOffset.y;
 		if (_bullet != nullptr) {
 			if (auto* _projectileComponent = _bullet->GetComponent<ProjectileComponent>()) {
-				_projectileComponent->Activate(&ParentEntity);
+				_projectileComponent->Activate(ParentEntity);
 			}
 			_bullet->SetPosition(_position);
 		}
 		if (!PhysicsHandle || PhysicsHandle->GetVelocity().x == 0) {
 			ParentEntity.GetSprite().SetFlipX(ParentEntity.GetDirection().x < 0);
-			Animator->PlayAnimation("shoot");
+			Animator->PlayAnimation(ShootAnimation);
 		}
 	}
 }
@@ -142,7 +153,7 @@ void PlayerComponent::ApplyMovementIntent()
 	if (!PhysicsHandle) {
 		return;
 	}
-	const float _deltaTime = Context.Get<RunnerService>().GetDeltaTime();
+	const float _deltaTime = Runner->GetDeltaTime();
 	if (_deltaTime <= 0.0f) {
 		return;
 	}
@@ -174,7 +185,7 @@ void PlayerComponent::SetVerticalVelocity(float y)
 
 void PlayerComponent::HandleInput()
 {
-	auto& _input = Context.Get<InputService>().GetInput();
+	auto& _input = Input->GetInput();
 
 	MovementIntent = Vec2(0.0f, 0.0f);
 
@@ -217,13 +228,13 @@ void PlayerComponent::OnDamage()
 
 	// Play damage animation
 	ParentEntity.GetSprite().SetFlipX(ParentEntity.GetDirection().x < 0);
-	Animator->PlayAnimation("damage");
+	Animator->PlayAnimation(DamageAnimation);
 
 	if (Lives <= 0) {
 		OnDeath();
 	} else {
 		IsInvulnerable = true;
-		InvulnerabilityEndTime = Context.Get<RunnerService>().GetElapsedTime() + InvulnerabilityDuration;
+		InvulnerabilityEndTime = Runner->GetElapsedTime() + InvulnerabilityDuration;
 	}
 }
 
@@ -242,9 +253,3 @@ void PlayerComponent::OnVictory()
 	Freeze();
 }
 
-void PlayerComponent::OnCollide(Entity& _other)
-{
-	if (_other.GetTag() == hazard || _other.GetTag() == enemy_bullet) {
-		OnDamage();
-	}
-}
@@ -1,6 +1,9 @@
 #include <game/components/ProjectileComponent.h>
 #include <core/engine/GameServiceHost.h>
+#include <core/engine/JobService.h>
 #include <core/engine/RunnerService.h>
+#include <core/engine/WorldService.h>
+#include <core/World.h>
 #include <game/components/PhysicsComponent.h>
 
 
@@ -8,7 +11,10 @@
 ProjectileComponent::ProjectileComponent(Entity& _entity, GameServiceHost& _context, float _speed, float _lifeSpan)
 	:Component(_entity, _context),
 	Speed(_speed),
-	LifeSpan(_lifeSpan)
+	LifeSpan(_lifeSpan),
+	Runner(_context),
+	Jobs(_context),
+	Worlds(_context)
 {
 }
 
@@ -19,17 +25,17 @@ ProjectileComponent::~ProjectileComponent()
 
 void ProjectileComponent::Start()
 {
-	SpawnTime = Context.Get<RunnerService>().GetElapsedTime();
+	SpawnTime = Runner->GetElapsedTime();
 	PhysicsHandle = ParentEntity.GetComponent<PhysicsComponent>();
-	if (Shooter) {
-		ParentEntity.SetDirection(Shooter->GetDirection());
+	if (const Entity* _shooter = Worlds->GetWorld().Resolve(Shooter)) {
+		ParentEntity.SetDirection(_shooter->GetDirection());
 	}
 }
 
 void ProjectileComponent::Update()
 {
-	if (Context.Get<RunnerService>().GetElapsedTime() > SpawnTime + LifeSpan){
-		ParentEntity.Disable();
+	if (Runner->GetElapsedTime() > SpawnTime + LifeSpan){
+		Jobs->Defer([this]() { ParentEntity.Disable(); });
 		return;
 	}
 	if (PhysicsHandle) {
@@ -37,30 +43,22 @@ void ProjectileComponent::Update()
 	}
 }
 
-void ProjectileComponent::PostUpdate()
-{
-}
-
-void ProjectileComponent::Activate(Entity* _shooter)
+void ProjectileComponent::Activate(const Entity& _shooter)
 {
 	SetShooter(_shooter);
-	SpawnTime = Context.Get<RunnerService>().GetElapsedTime();
+	SpawnTime = Runner->GetElapsedTime();
 }
 
-void ProjectileComponent::SetShooter(Entity* _shooter)
+void ProjectileComponent::SetShooter(const Entity& _shooter)
 {
-	Shooter = _shooter;
-	if (Shooter) {
-		ParentEntity.SetDirection(Shooter->GetDirection());
-	}
+	Shooter = _shooter.GetHandle();
+	ParentEntity.SetDirection(_shooter.GetDirection());
 }
 
-void ProjectileComponent::OnCollide(Entity& _other)
+void ProjectileComponent::OnHit(Entity& _other)
 {
-	//don't let scorpions block the bull from getting the player
-	if (ParentEntity.GetTag() == enemy_bullet && _other.GetTag() == hazard) return;
-	//don't detect collsion with its own shooter or other projectiles
-	if ((!Shooter || &_other != Shooter) && _other.GetTag() != bullet && _other.GetTag() != enemy_bullet) {
+	//don't detect collsion with its own shooter
+	if (_other.GetHandle() != Shooter) {
 		ParentEntity.Disable();
 	}
 }